@@ -1,6 +1,7 @@
 #include <algorithm>
 #include <iostream>
 #include <string>
+#include <thread>
 #include <vector>
 
 std::vector<size_t> GetZFunction(const std::string& string) {
@@ -12,7 +13,8 @@ std::vector<size_t> GetZFunction(const std::string& string) {
     if (i <= right) {
       z_func[i] = std::min(z_func[i - left], right - i + 1);
     }
-    while (i + z_func[i] < str_size && string[z_func[i]] == string[i + z_func[i]]) {
+    while (i + z_func[i] < str_size &&
+           string[z_func[i]] == string[i + z_func[i]]) {
       ++z_func[i];
     }
     if (i + z_func[i] - 1 > right) {
@@ -23,15 +25,83 @@ std::vector<size_t> GetZFunction(const std::string& string) {
   return z_func;
 }
 
+// occurrences of the pattern starting in text[begin..end), reads the text up
+// to end + |pattern| - 1; [left, right) is the rightmost match with a prefix
+std::vector<size_t> FindOccurrencesInChunk(
+    const std::string& text, const std::string& pattern,
+    const std::vector<size_t>& pattern_z_func, size_t begin, size_t end) {
+  size_t text_size = text.size();
+  size_t pattern_size = pattern.size();
+  std::vector<size_t> occurrences;
+  size_t left = begin;
+  size_t right = begin;
+
+  for (size_t i = begin; i < end && i + pattern_size <= text_size; ++i) {
+    size_t match = 0;
+    if (i < right) {
+      match = std::min(pattern_z_func[i - left], right - i);
+    }
+    if (i + match >= right) {
+      while (match < pattern_size && i + match < text_size &&
+             pattern[match] == text[i + match]) {
+        ++match;
+      }
+      left = i;
+      right = i + match;
+    }
+    if (match == pattern_size) {
+      occurrences.push_back(i);
+    }
+  }
+
+  return occurrences;
+}
+
+// text is split into one chunk per thread, the pattern Z-function is shared
+std::vector<size_t> FindPatternOccurrences(const std::string& text,
+                                           const std::string& pattern,
+                                           size_t thread_count) {
+  if (pattern.empty() || pattern.size() > text.size()) {
+    return {};
+  }
+
+  auto pattern_z_func = GetZFunction(pattern);
+  size_t positions = text.size() - pattern.size() + 1;
+  thread_count = std::max<size_t>(1, std::min(thread_count, positions));
+  size_t chunk_size = (positions + thread_count - 1) / thread_count;
+
+  std::vector<std::vector<size_t>> chunk_occurrences(thread_count);
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < thread_count; ++t) {
+    size_t begin = std::min(positions, t * chunk_size);
+    size_t end = std::min(positions, begin + chunk_size);
+    threads.emplace_back([&, t, begin, end] {
+      chunk_occurrences[t] =
+          FindOccurrencesInChunk(text, pattern, pattern_z_func, begin, end);
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  std::vector<size_t> occurrences;
+  for (const auto& chunk : chunk_occurrences) {
+    occurrences.insert(occurrences.end(), chunk.begin(), chunk.end());
+  }
+  return occurrences;
+}
+
 void PrintPatternOccurrencesInString(const std::string& string,
                                      const std::string& pattern) {
-  auto z_func = GetZFunction(pattern + '#' + string);
+  size_t thread_count = std::max(1u, std::thread::hardware_concurrency());
+  std::string output;
 
-  for (size_t i = 0; i < z_func.size(); ++i) {
-    if (z_func[i] == pattern.size()) {
-      std::cout << i - (1 + pattern.size()) << '\n';
-    }
+  for (size_t position :
+       FindPatternOccurrences(string, pattern, thread_count)) {
+    output += std::to_string(position);
+    output += '\n';
   }
+  std::cout << output;
 }
 
 int main() {
@@ -1,36 +1,66 @@
+#include <cstdint>
 #include <iostream>
+#include <optional>
 #include <string>
 #include <vector>
 
-std::string BuildFromPrefix(const std::vector<int>& p) {
-  static std::string alphabet = "abcdefghijklmnopqrstuvwxyz";
-  std::string str{};
-
-  for (size_t i = 0; i < p.size(); ++i) {
-    if (p[i] == 0) {
-      bool found_candidate = false;
-      for (char candidate : alphabet) {
-        size_t j = (i > 0 ? p[i - 1] : 0);
-        while (str[j] != candidate && j > 0) {
-          j = p[j - 1];
-        }
-        if (str[j] == candidate) {
-          ++j;
-        }
-        if (j == 0) {
-          str += candidate;
-          found_candidate = true;
-          break;
-        }
+std::vector<int> GetPrefixFunction(const std::string& str) {
+  std::vector<int> p(str.size(), 0);
+  for (size_t i = 1; i < str.size(); ++i) {
+    int j = p[i - 1];
+    while (j > 0 && str[i] != str[j]) {
+      j = p[j - 1];
+    }
+    if (str[i] == str[j]) {
+      ++j;
+    }
+    p[i] = j;
+  }
+  return p;
+}
+
+// lexicographically minimal string over 'a'..'z', std::nullopt if p is not
+// a prefix function; for p[i] = 0 the letters extending any border of the
+// previous prefix are forbidden, extend_mask[k] accumulates them along the
+// failure chain k, p[k - 1], ..., 0 so every position costs O(1)
+std::optional<std::string> BuildFromPrefix(const std::vector<int>& p) {
+  static const int kAlphabetSize = 26;
+  static const uint32_t kFullMask = (1u << kAlphabetSize) - 1;
+
+  size_t n = p.size();
+  std::string str(n, 'a');
+  std::vector<uint32_t> extend_mask(n, 0);
+
+  for (size_t i = 0; i < n; ++i) {
+    int previous = (i > 0) ? p[i - 1] : 0;
+    if (p[i] < 0 || p[i] > previous + 1 || (i == 0 && p[i] != 0)) {
+      return std::nullopt;
+    }
+
+    if (p[i] > 0) {
+      str[i] = str[p[i] - 1];
+    } else if (i > 0) {
+      uint32_t forbidden = extend_mask[previous];
+      if (forbidden == kFullMask) {
+        return std::nullopt;
       }
-    } else {
-      str += str[p[i] - 1];
-    } 
+      str[i] = 'a' + __builtin_ctz(~forbidden);
+    }
+
+    extend_mask[i] =
+        (1u << (str[i] - 'a')) | (i > 0 ? extend_mask[previous] : 0);
+  }
+
+  if (GetPrefixFunction(str) != p) {
+    return std::nullopt;
   }
   return str;
 }
 
 int main() {
+  std::ios::sync_with_stdio(false);
+  std::cin.tie(nullptr);
+
   size_t n = 0;
   std::cin >> n;
   std::vector<int> p(n);
@@ -39,7 +69,9 @@ int main() {
     std::cin >> p[i];
   }
 
-  std::cout << BuildFromPrefix(p) << "\n";
+  auto str = BuildFromPrefix(p);
+
+  std::cout << (str ? *str : "-1") << "\n";
 
   return 0;
-}
+}
\ No newline at end of file
@@ -1,59 +1,157 @@
+#include <algorithm>
+#include <cstdint>
 #include <iostream>
+#include <optional>
 #include <string>
 #include <vector>
 
-std::string BuildFromPrefix(const std::vector<int>& p) {
-  static std::string alphabet = "abcdefghijklmnopqrstuvwxyz";
-  std::string str{};
-
-  for (size_t i = 0; i < p.size(); ++i) {
-    if (p[i] == 0) {
-      bool found_candidate = false;
-      for (char candidate : alphabet) {
-        size_t j = (i > 0 ? p[i - 1] : 0);
-        while (str[j] != candidate && j > 0) {
-          j = p[j - 1];
-        }
-        if (str[j] == candidate) {
-          ++j;
-        }
-        if (j == 0) {
-          str += candidate;
-          found_candidate = true;
-          break;
-        }
-      }
-    } else {
-      str += str[p[i] - 1];
+// all conversions are O(n), arrays are int to keep n = 10^8 in memory
+
+std::vector<int> GetPrefixFunction(const std::string& str) {
+  std::vector<int> p(str.size(), 0);
+  for (size_t i = 1; i < str.size(); ++i) {
+    int j = p[i - 1];
+    while (j > 0 && str[i] != str[j]) {
+      j = p[j - 1];
+    }
+    if (str[i] == str[j]) {
+      ++j;
     }
+    p[i] = j;
   }
-  return str;
+  return p;
 }
 
-std::vector<int> FromZToPrefix(const std::vector<size_t>& z) {
-  std::vector<int> p(z.size(), 0);
-  for(int i = 1; i < z.size(); i++) {
-    if(z[i] != 0) {
-      for (int j = z[i] - 1; j >= 0 && !(p[i + j]); j--) {
-        p[i + j] = j + 1;
-      }
+std::vector<int> GetZFunction(const std::string& str) {
+  int n = str.size();
+  std::vector<int> z(n, 0);
+  int left = 0;
+  int right = 0;
+  for (int i = 1; i < n; ++i) {
+    if (i <= right) {
+      z[i] = std::min(z[i - left], right - i + 1);
+    }
+    while (i + z[i] < n && str[z[i]] == str[i + z[i]]) {
+      ++z[i];
+    }
+    if (i + z[i] - 1 > right) {
+      left = i;
+      right = i + z[i] - 1;
+    }
+  }
+  return z;
+}
+
+// p[i + z[i] - 1] >= z[i] and p[i] >= p[i + 1] - 1
+std::vector<int> FromZToPrefix(const std::vector<int>& z) {
+  int n = z.size();
+  std::vector<int> p(n, 0);
+  for (int i = 1; i < n; ++i) {
+    int length = std::min(z[i], n - i);
+    if (length > 0) {
+      p[i + length - 1] = std::max(p[i + length - 1], length);
     }
   }
+  for (int i = n - 2; i > 0; --i) {
+    p[i] = std::max(p[i], p[i + 1] - 1);
+  }
   return p;
 }
 
+// every border ending at i starts a Z-block at i - p[i] + 1, the blocks are
+// then expanded by copying z[1..z[i]) until a longer value shows up
+std::vector<int> FromPrefixToZ(const std::vector<int>& p) {
+  int n = p.size();
+  std::vector<int> z(n, 0);
+  for (int i = 1; i < n; ++i) {
+    if (p[i] > 0) {
+      z[i - p[i] + 1] = p[i];
+    }
+  }
+  if (n > 0) {
+    z[0] = n;
+  }
+
+  for (int i = 1; i < n;) {
+    int last = i;
+    for (int j = 1; j < z[i] && z[i + j] <= z[j]; ++j) {
+      z[i + j] = std::min(z[j], z[i] - j);
+      last = i + j;
+    }
+    i = last + 1;
+  }
+
+  if (n > 0) {
+    z[0] = 0;
+  }
+  return z;
+}
+
+// lexicographically minimal string over 'a'..'z', std::nullopt if p is not
+// a prefix function; for p[i] = 0 the letters extending any border of the
+// previous prefix are forbidden, extend_mask[k] accumulates them along the
+// failure chain k, p[k - 1], ..., 0 so every position costs O(1)
+std::optional<std::string> BuildFromPrefix(const std::vector<int>& p) {
+  static const int kAlphabetSize = 26;
+  static const uint32_t kFullMask = (1u << kAlphabetSize) - 1;
+
+  size_t n = p.size();
+  std::string str(n, 'a');
+  std::vector<uint32_t> extend_mask(n, 0);
+
+  for (size_t i = 0; i < n; ++i) {
+    int previous = (i > 0) ? p[i - 1] : 0;
+    if (p[i] < 0 || p[i] > previous + 1 || (i == 0 && p[i] != 0)) {
+      return std::nullopt;
+    }
+
+    if (p[i] > 0) {
+      str[i] = str[p[i] - 1];
+    } else if (i > 0) {
+      uint32_t forbidden = extend_mask[previous];
+      if (forbidden == kFullMask) {
+        return std::nullopt;
+      }
+      str[i] = 'a' + __builtin_ctz(~forbidden);
+    }
+
+    extend_mask[i] =
+        (1u << (str[i] - 'a')) | (i > 0 ? extend_mask[previous] : 0);
+  }
+
+  if (GetPrefixFunction(str) != p) {
+    return std::nullopt;
+  }
+  return str;
+}
+
+std::optional<std::string> BuildFromZ(std::vector<int> z) {
+  if (!z.empty()) {
+    z[0] = 0;
+  }
+
+  auto str = BuildFromPrefix(FromZToPrefix(z));
+  if (!str || GetZFunction(*str) != z) {
+    return std::nullopt;
+  }
+  return str;
+}
+
 int main() {
+  std::ios::sync_with_stdio(false);
+  std::cin.tie(nullptr);
+
   size_t n = 0;
   std::cin >> n;
-  std::vector<size_t> z(n);
+  std::vector<int> z(n);
 
   for (size_t i = 0; i < n; ++i) {
     std::cin >> z[i];
   }
 
-  z[0] = 0;
+  auto str = BuildFromZ(std::move(z));
 
-  std::cout << BuildFromPrefix(FromZToPrefix(z)) << "\n";
+  std::cout << (str ? *str : "-1") << "\n";
 
   return 0;
 }
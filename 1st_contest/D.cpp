@@ -1,41 +1,178 @@
+#include <algorithm>
+#include <cassert>
+#include <cstdlib>
+#include <ctime>
 #include <iostream>
+#include <sstream>
 #include <string>
+#include <string_view>
 #include <vector>
 
-size_t GetMaxOverlap(const std::string& lhs_str, const std::string& rhs_str) {
-  size_t m = lhs_str.size();
-  size_t n = rhs_str.size();
-  size_t max_overlap = 0;
+// input limit of the problem, also bounds every single word; a streaming
+// merger cannot see the lengths of words it has not read yet, so the window
+// is sized from the limit and longer words are rejected
+const size_t kMaxWordLength = 1'000'000;
 
-  for (size_t i = 1; i <= std::min(m, n); ++i) {
-    if (lhs_str.substr(m - i) == rhs_str.substr(0, i)) {
-      max_overlap = i;
+void ComputePrefixFunction(std::string_view str, std::vector<size_t>& prefix) {
+  prefix.assign(str.size(), 0);
+  for (size_t i = 1; i < str.size(); ++i) {
+    size_t j = prefix[i - 1];
+    while (j > 0 && str[i] != str[j]) {
+      j = prefix[j - 1];
     }
+    if (str[i] == str[j]) {
+      ++j;
+    }
+    prefix[i] = j;
+  }
+}
+
+// longest suffix of tail equal to a prefix of word: the prefix-function pass
+// over word + '#' + tail, the tail half runs as KMP without building the
+// concatenation
+size_t GetMaxOverlap(std::string_view tail, std::string_view word,
+                     std::vector<size_t>& prefix) {
+  if (word.empty()) {
+    return 0;
+  }
+
+  ComputePrefixFunction(word, prefix);
+
+  size_t j = 0;
+  for (char character : tail) {
+    if (j == word.size()) {
+      j = prefix[j - 1];
+    }
+    while (j > 0 && character != word[j]) {
+      j = prefix[j - 1];
+    }
+    if (character == word[j]) {
+      ++j;
+    }
+  }
+  return j;
+}
+
+// keeps only the last max_word_length characters of the pun that a future
+// overlap may touch, everything before them is written out
+class PunMerger {
+ public:
+  PunMerger(std::ostream& out, size_t max_word_length)
+      : out_(out), max_word_length_(max_word_length) {}
+
+  // false if the word is longer than the window: its overlap may reach into
+  // the part of the pun that is already written out
+  bool Append(std::string_view word) {
+    if (word.size() > max_word_length_) {
+      return false;
+    }
+
+    size_t tail_length = std::min(word.size(), pun_tail_.size());
+    std::string_view tail(pun_tail_);
+    size_t overlap =
+        GetMaxOverlap(tail.substr(pun_tail_.size() - tail_length), word,
+                      prefix_);
+
+    pun_tail_.append(word.substr(overlap));
+
+    if (pun_tail_.size() > 2 * max_word_length_) {
+      size_t flushed = pun_tail_.size() - max_word_length_;
+      out_.write(pun_tail_.data(), flushed);
+      pun_tail_.erase(0, flushed);
+    }
+    return true;
+  }
+
+  void Flush() {
+    out_ << pun_tail_;
+    pun_tail_.clear();
   }
 
-  return max_overlap;
+ private:
+  std::ostream& out_;
+  size_t max_word_length_;
+  std::string pun_tail_;
+  std::vector<size_t> prefix_;
+};
+
+// the original quadratic merge over the whole pun
+std::string NaiveMerge(const std::vector<std::string>& words) {
+  std::string pun;
+  for (const std::string& word : words) {
+    size_t overlap = 0;
+    for (size_t i = 1; i <= std::min(pun.size(), word.size()); ++i) {
+      if (pun.compare(pun.size() - i, i, word, 0, i) == 0) {
+        overlap = i;
+      }
+    }
+    pun += word.substr(overlap);
+  }
+  return pun;
+}
+
+std::string MergeWithWindow(const std::vector<std::string>& words,
+                            size_t max_word_length) {
+  std::ostringstream out;
+  PunMerger merger(out, max_word_length);
+  for (const std::string& word : words) {
+    bool appended = merger.Append(word);
+    assert(appended);
+  }
+  merger.Flush();
+  return out.str();
 }
 
-void MergeIntoPun(std::string& old_pun, const std::string& next_word) {
-  size_t overlap = GetMaxOverlap(old_pun, next_word);
+// random words over {a, b} against NaiveMerge with a window as small as the
+// longest word, so every test flushes; then a word of the window size
+// overlapping a longer run of the pun, and a word over the window
+void StressTest(int num_tests, int max_length) {
+  srand(time(nullptr));
 
-  old_pun += next_word.substr(overlap);
+  for (int test = 1; test <= num_tests; ++test) {
+    std::vector<std::string> words(rand() % 20 + 1);
+    for (std::string& word : words) {
+      word.resize(rand() % max_length + 1);
+      for (char& character : word) {
+        character = 'a' + rand() % 2;
+      }
+    }
+    assert(MergeWithWindow(words, max_length) == NaiveMerge(words));
+  }
+
+  size_t window = max_length;
+  std::vector<std::string> words = {"b" + std::string(window - 1, 'a'),
+                                    std::string(window - 1, 'a') + "c"};
+  assert(MergeWithWindow(words, window) == NaiveMerge(words));
+
+  std::ostringstream out;
+  PunMerger merger(out, window);
+  assert(!merger.Append(std::string(window + 1, 'a')));
+
+  std::cout << "OK\n";
 }
 
 int main() {
+  std::ios::sync_with_stdio(false);
+  std::cin.tie(nullptr);
+
   size_t n = 0;
   std::cin >> n;
 
-  std::string old_pun;
-  std::cin >> old_pun;
+  PunMerger merger(std::cout, kMaxWordLength);
 
-  for (size_t i = 1; i < n; ++i) {
-    std::string next_word;
+  std::string next_word;
+  for (size_t i = 0; i < n; ++i) {
     std::cin >> next_word;
-    MergeIntoPun(old_pun, next_word);
+    if (!merger.Append(next_word)) {
+      std::cerr << "word longer than " << kMaxWordLength << " characters\n";
+      return 1;
+    }
   }
 
-  std::cout << old_pun << '\n';
+  merger.Flush();
+  std::cout << '\n';
+
+  // StressTest(1000, 10);
 
   return 0;
-}
\ No newline at end of file
+}
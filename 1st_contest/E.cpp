@@ -1,4 +1,5 @@
 #include <algorithm>
+#include <chrono>
 #include <iostream>
 #include <string>
 #include <vector>
@@ -19,6 +20,32 @@ std::string GenerateRandomString(int length) {
   return str;
 }
 
+// Проверка ответа: вердикт совпадает с ожидаемым, а после "No" идут
+// непустые префиксы s, которые в сумме дают t. Разбиений может быть
+// несколько, поэтому сами строки ответов не сравниваются
+bool IsCorrectAnswer(const std::string& s, const std::string& t,
+                     const std::string& expected_verdict,
+                     const std::string& output) {
+  std::istringstream input(output);
+  std::string verdict;
+  if (!(input >> verdict) || verdict != expected_verdict) {
+    return false;
+  }
+  if (verdict != "No") {
+    return true;
+  }
+
+  std::string concatenation;
+  std::string part;
+  while (input >> part) {
+    if (part.size() > s.size() || s.compare(0, part.size(), part) != 0) {
+      return false;
+    }
+    concatenation += part;
+  }
+  return concatenation == t;
+}
+
 // Стресс-тестирование
 void StressTest(int num_tests, int max_length) {
   srand(time(nullptr));  // Инициализация генератора случайных чисел
@@ -42,7 +69,10 @@ void StressTest(int num_tests, int max_length) {
 
     std::cout.rdbuf(cout_buf);  // Возвращаем стандартный вывод
 
-    if (naive_output.str() != fast_output.str()) {
+    std::string expected_verdict;
+    std::istringstream(naive_output.str()) >> expected_verdict;
+
+    if (!IsCorrectAnswer(s, t, expected_verdict, fast_output.str())) {
       std::cout << "❌ Ошибка на тесте #" << test << ":\n";
       std::cout << "S = \"" << s << "\", T = \"" << t << "\"\n";
       std::cout << "Наивное решение:\n" << naive_output.str();
@@ -109,56 +139,121 @@ std::vector<int> GetZFunction(const std::string& str) {
   return z;
 }
 
+// match[j] = LCP(t[j..], s), Z-function of s applied to t without building
+// s + '#' + t; [left, right) is the rightmost matched block
+std::vector<int> GetPrefixMatches(const std::string& s, const std::string& t) {
+  auto z = GetZFunction(s);
+  int n = s.size();
+  int m = t.size();
+  std::vector<int> match(m, 0);
+  int left = 0;
+  int right = 0;
+
+  for (int j = 0; j < m; ++j) {
+    if (j < right) {
+      match[j] = std::min(z[j - left], right - j);
+    }
+    if (j + match[j] >= right) {
+      while (match[j] < n && j + match[j] < m &&
+             s[match[j]] == t[j + match[j]]) {
+        ++match[j];
+      }
+      left = j;
+      right = j + match[j];
+    }
+  }
+
+  return match;
+}
+
+// greedy cover of t by prefixes of s: from a cut at start the next cut is
+// the j in (start, reach] with the farthest j + match[j]; cuts before the old
+// reach never beat the current one, so every j is scanned once, O(|s| + |t|)
 void CheckIfInteresting(const std::string& s, const std::string& t) {
-  std::string str = s + '#' + t;
-  auto z = GetZFunction(str);
-  size_t n = s.size();
+  auto match = GetPrefixMatches(s, t);
   size_t m = t.size();
 
-  size_t it = n + 1;
-  size_t count = 0;
-  std::vector<int> result;
+  std::vector<size_t> result;
+  size_t start = 0;
+  size_t reach = (m > 0) ? match[0] : 0;
+  size_t scanned = 0;
 
-  while (it < z.size()) {
-    size_t next_it = it;
-    size_t max_len = 0;
-    size_t it2 = it;
-
-    for (; it2 < std::min(it + z[it] + 1, z.size()); ++it2) {
-      if (z[it2] + (it2 - it) >= max_len) {
-        max_len = z[it2] + (it2 - it);
-        next_it = it2;
+  while (reach < m) {
+    size_t next_start = start;
+    size_t next_reach = reach;
+    for (size_t j = scanned + 1; j <= reach; ++j) {
+      if (j + match[j] >= next_reach) {
+        next_reach = j + match[j];
+        next_start = j;
       }
     }
+    scanned = reach;
 
-    size_t prefix_len = next_it - it;
-    prefix_len = (prefix_len == 0 && it2 == z.size()) ? z[it] : prefix_len;
-    result.push_back(prefix_len);
-    count += prefix_len;
-
-    if (it == next_it) {
-      break;
+    if (next_reach == reach) {
+      std::cout << "Yes\n";
+      return;
     }
-    it = next_it;
-  }
 
-  if (count < m) {
-    std::cout << "Yes\n";
-    return;
+    result.push_back(next_start - start);
+    start = next_start;
+    reach = next_reach;
   }
+  result.push_back(m - start);
 
   std::cout << "No\n";
-  size_t counter = 0;
   for (auto i : result) {
-    counter += i;
-    if (counter > m) {
-      break;
-    }
     std::cout << s.substr(0, i) << ' ';
   }
   std::cout << '\n';
 }
 
+// time of both solutions on decomposable t of growing length, printed as
+// csv for plotting; the naive one is exponential, so it stops at naive_limit;
+// both answers go through the StressTest checker
+void ScalingBenchmark(int max_length, int naive_limit) {
+  std::cout << "length,naive_ms,fast_ms\n";
+
+  for (int length = 8; length <= max_length; length *= 2) {
+    std::string s = GenerateRandomString(length);
+    std::string t;
+    while (static_cast<int>(t.size()) < length) {
+      t += s.substr(0, rand() % length + 1);
+    }
+
+    std::ostringstream naive_output, fast_output;
+    std::streambuf* cout_buf = std::cout.rdbuf();
+
+    double naive_ms = -1;
+    if (length <= naive_limit) {
+      std::cout.rdbuf(naive_output.rdbuf());
+      auto start = std::chrono::steady_clock::now();
+      NaiveSolution(s, t);
+      naive_ms = std::chrono::duration<double, std::milli>(
+                     std::chrono::steady_clock::now() - start)
+                     .count();
+    }
+
+    std::cout.rdbuf(fast_output.rdbuf());
+    auto start = std::chrono::steady_clock::now();
+    CheckIfInteresting(s, t);
+    double fast_ms = std::chrono::duration<double, std::milli>(
+                         std::chrono::steady_clock::now() - start)
+                         .count();
+
+    std::cout.rdbuf(cout_buf);
+
+    // t is glued from prefixes of s, so "No" is expected at every length
+    assert(IsCorrectAnswer(s, t, "No", fast_output.str()));
+    assert(naive_ms < 0 || IsCorrectAnswer(s, t, "No", naive_output.str()));
+
+    std::cout << length << ',';
+    if (naive_ms >= 0) {
+      std::cout << naive_ms;
+    }
+    std::cout << ',' << fast_ms << '\n';
+  }
+}
+
 int main() {
   std::string s;
   std::string t;
@@ -172,5 +267,7 @@ int main() {
 
   // StressTest(1000, 10);
 
+  // ScalingBenchmark(1 << 22, 1 << 10);
+
   return 0;
 }
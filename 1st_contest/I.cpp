@@ -1,76 +1,170 @@
+#include <algorithm>
+#include <array>
 #include <cstdint>
 #include <iostream>
-#include <set>
 #include <string>
-#include <unordered_map>
+#include <utility>
 #include <vector>
 
-const uint64_t KHashPrimary1 = 313;
-const uint64_t KHashPrimary2 = 317;
+struct StringInfo {
+  uint64_t index;
+  uint64_t begin;
+  uint64_t end;
+};
 
-struct HashPair {
-  uint64_t hash1, hash2;
-  bool operator==(const HashPair& other) const {
-    return hash1 == other.hash1 && hash2 == other.hash2;
+// odd_radius[i]  - number of odd palindromes centered at i
+// even_radius[i] - number of even palindromes centered between i - 1 and i
+class Manacher {
+ public:
+  explicit Manacher(const std::string& str)
+      : odd_radius_(str.size(), 0), even_radius_(str.size(), 0) {
+    int64_t n = str.size();
+
+    for (int64_t i = 0, left = 0, right = -1; i < n; ++i) {
+      int64_t radius =
+          (i > right) ? 1 : std::min<int64_t>(odd_radius_[left + right - i],
+                                              right - i + 1);
+      while (i - radius >= 0 && i + radius < n &&
+             str[i - radius] == str[i + radius]) {
+        ++radius;
+      }
+      odd_radius_[i] = radius;
+      if (i + radius - 1 > right) {
+        left = i - radius + 1;
+        right = i + radius - 1;
+      }
+    }
+
+    for (int64_t i = 0, left = 0, right = -1; i < n; ++i) {
+      int64_t radius =
+          (i > right) ? 0 : std::min<int64_t>(even_radius_[left + right - i + 1],
+                                              right - i + 1);
+      while (i - radius - 1 >= 0 && i + radius < n &&
+             str[i - radius - 1] == str[i + radius]) {
+        ++radius;
+      }
+      even_radius_[i] = radius;
+      if (i + radius - 1 > right) {
+        left = i - radius;
+        right = i + radius - 1;
+      }
+    }
   }
-};
 
-std::vector<HashPair> ComputePrefixHashes(const std::string& str, uint64_t n) {
-  std::vector<HashPair> hash(n + 1, {0, 0});
-  for (uint64_t i = 0; i < n; ++i) {
-    hash[i + 1].hash1 = (hash[i].hash1 * KHashPrimary1 + uint64_t(str[i]));
-    hash[i + 1].hash2 = (hash[i].hash2 * KHashPrimary2 + uint64_t(str[i]));
+  // str[l..r)
+  bool IsPalindrome(uint64_t l, uint64_t r) const {
+    uint64_t length = r - l;
+    if (length == 0) {
+      return true;
+    }
+    if (length % 2 == 1) {
+      return odd_radius_[l + length / 2] >= (length + 1) / 2;
+    }
+    return even_radius_[l + length / 2] >= length / 2;
   }
-  return hash;
-}
 
-std::vector<HashPair> ComputeReversedPrefixHashes(const std::string& str,
-                                                  uint64_t n) {
-  std::vector<HashPair> hash(n + 1, {0, 0});
-  for (uint64_t i = 0; i < n; ++i) {
-    hash[i + 1].hash1 =
-        (hash[i].hash1 * KHashPrimary1 + uint64_t(str[n - i - 1]));
-    hash[i + 1].hash2 =
-        (hash[i].hash2 * KHashPrimary2 + uint64_t(str[n - i - 1]));
+ private:
+  std::vector<uint64_t> odd_radius_;
+  std::vector<uint64_t> even_radius_;
+};
+
+// trie of reversed strings; every node also keeps the strings whose
+// reversed remainder below it is a non-empty palindrome
+class ReversedTrie {
+ public:
+  static const size_t kAlphabetSize = 26;
+  static const char kFirstChar = 'a';
+  static const uint32_t kNone = UINT32_MAX;
+
+  explicit ReversedTrie(uint64_t total_length) {
+    children_.reserve(total_length + 1);
+    children_.emplace_back();
+    children_.back().fill(kNone);
+    ending_head_.push_back(kNone);
+    palindrome_head_.push_back(kNone);
   }
-  return hash;
-}
 
-std::vector<HashPair> ComputePowers(uint64_t n) {
-  std::vector<HashPair> power(n + 1, {1, 1});
-  for (uint64_t i = 1; i <= n; ++i) {
-    power[i].hash1 = (power[i - 1].hash1 * KHashPrimary1);
-    power[i].hash2 = (power[i - 1].hash2 * KHashPrimary2);
+  void AddString(const std::string& merged_string, const StringInfo& info,
+                 const Manacher& manacher) {
+    uint32_t current = 0;
+    for (uint64_t i = info.end; i > info.begin; --i) {
+      // reversed remainder below is str[begin..i), i > begin
+      if (manacher.IsPalindrome(info.begin, i)) {
+        palindrome_list_.push_back({static_cast<uint32_t>(info.index),
+                                    palindrome_head_[current]});
+        palindrome_head_[current] = palindrome_list_.size() - 1;
+      }
+
+      size_t index = merged_string[i - 1] - kFirstChar;
+      if (children_[current][index] == kNone) {
+        children_[current][index] = children_.size();
+        children_.emplace_back();
+        children_.back().fill(kNone);
+        ending_head_.push_back(kNone);
+        palindrome_head_.push_back(kNone);
+      }
+      current = children_[current][index];
+    }
+
+    ending_list_.push_back(
+        {static_cast<uint32_t>(info.index), ending_head_[current]});
+    ending_head_[current] = ending_list_.size() - 1;
   }
-  return power;
-}
 
-HashPair GetSubstrHash(const std::vector<HashPair>& hash,
-                       const std::vector<HashPair>& power, uint64_t l,
-                       uint64_t r) {
-  return {(hash[r].hash1 - (hash[l].hash1 * power[r - l].hash1)),
-          (hash[r].hash2 - (hash[l].hash2 * power[r - l].hash2))};
-}
+  // appends every (info.index, j) such that str_i + str_j is a palindrome
+  void CollectPairs(const std::string& merged_string, const StringInfo& info,
+                    const Manacher& manacher,
+                    std::vector<std::pair<uint32_t, uint32_t>>& result) const {
+    uint32_t left = info.index;
+    uint32_t current = 0;
+
+    for (uint64_t i = info.begin;; ++i) {
+      // |str_j| <= |str_i|: str_i = reverse(str_j) + palindrome
+      if (manacher.IsPalindrome(i, info.end)) {
+        AppendList(ending_list_, ending_head_[current], left, result);
+      }
+      if (i == info.end) {
+        break;
+      }
 
-struct StringInfo {
-  uint64_t index;
-  uint64_t begin;
-  uint64_t end;
-  HashPair hash;
-  HashPair reverse_hash;
-};
+      size_t index = merged_string[i] - kFirstChar;
+      current = children_[current][index];
+      if (current == kNone) {
+        return;
+      }
+    }
 
-bool IsPalindrome(uint64_t l, uint64_t r,
-                  const std::vector<HashPair>& prefix_hashes,
-                  const std::vector<HashPair>& powers,
-                  const std::vector<HashPair>& reversed_prefix_hashes,
-                  uint64_t str_len) {
-  return GetSubstrHash(prefix_hashes, powers, l, r) ==
-         GetSubstrHash(reversed_prefix_hashes, powers, str_len - r,
-                       str_len - l);
-}
+    // |str_j| > |str_i|: reverse(str_j) = str_i + palindrome
+    AppendList(palindrome_list_, palindrome_head_[current], left, result);
+  }
+
+ private:
+  struct ListEntry {
+    uint32_t index;
+    uint32_t next;
+  };
+
+  std::vector<std::array<uint32_t, kAlphabetSize>> children_;
+  std::vector<uint32_t> ending_head_;
+  std::vector<uint32_t> palindrome_head_;
+  std::vector<ListEntry> ending_list_;
+  std::vector<ListEntry> palindrome_list_;
+
+  static void AppendList(const std::vector<ListEntry>& list, uint32_t head,
+                         uint32_t left,
+                         std::vector<std::pair<uint32_t, uint32_t>>& result) {
+    for (uint32_t it = head; it != kNone; it = list[it].next) {
+      if (list[it].index != left) {
+        result.emplace_back(left, list[it].index);
+      }
+    }
+  }
+};
 
 int main() {
+  std::ios::sync_with_stdio(false);
+  std::cin.tie(nullptr);
+
   uint64_t n = 0;
   std::cin >> n;
 
@@ -86,54 +180,30 @@ int main() {
     string_data[i].index = i;
   }
 
-  std::vector<HashPair> prefix_hashes =
-      ComputePrefixHashes(merged_string, merged_string.size());
-  std::vector<HashPair> reversed_prefix_hashes =
-      ComputeReversedPrefixHashes(merged_string, merged_string.size());
-  std::vector<HashPair> powers = ComputePowers(merged_string.size());
-
-  std::unordered_map<uint64_t, StringInfo> reverse_hashes_map;
+  // palindromes are checked only inside [begin, end), so one pass over the
+  // merged string serves every word
+  Manacher manacher(merged_string);
 
-  for (uint64_t i = 0; i < n; ++i) {
-    string_data[i].hash = GetSubstrHash(
-        prefix_hashes, powers, string_data[i].begin, string_data[i].end);
-    string_data[i].reverse_hash =
-        GetSubstrHash(reversed_prefix_hashes, powers,
-                      merged_string.size() - string_data[i].end,
-                      merged_string.size() - string_data[i].begin);
-    reverse_hashes_map.insert(
-        {string_data[i].reverse_hash.hash1, string_data[i]});
+  ReversedTrie trie(merged_string.size());
+  for (auto& elem : string_data) {
+    trie.AddString(merged_string, elem, manacher);
   }
 
-  std::set<std::pair<uint64_t, uint64_t>> result;
-
+  std::vector<std::pair<uint32_t, uint32_t>> result;
   for (auto& elem : string_data) {
-    for (uint64_t i = elem.begin; i <= elem.end; ++i) {
-      if (IsPalindrome(elem.begin, i, prefix_hashes, powers,
-                       reversed_prefix_hashes, merged_string.size())) {
-        uint64_t substr_hash =
-            GetSubstrHash(prefix_hashes, powers, i, elem.end).hash1;
-        auto it = reverse_hashes_map.find(substr_hash);
-        if (it != reverse_hashes_map.end() && it->second.index != elem.index) {
-          result.emplace(it->second.index, elem.index);
-        }
-      }
-      if (IsPalindrome(i, elem.end, prefix_hashes, powers,
-                       reversed_prefix_hashes, merged_string.size())) {
-        uint64_t substr_hash =
-            GetSubstrHash(prefix_hashes, powers, elem.begin, i).hash1;
-        auto it = reverse_hashes_map.find(substr_hash);
-        if (it != reverse_hashes_map.end() && it->second.index != elem.index) {
-          result.emplace(elem.index, it->second.index);
-        }
-      }
-    }
+    size_t first = result.size();
+    trie.CollectPairs(merged_string, elem, manacher, result);
+    std::sort(result.begin() + first, result.end());
   }
 
-  std::cout << result.size() << '\n';
+  std::string output = std::to_string(result.size()) + '\n';
   for (auto& elem : result) {
-    std::cout << elem.first + 1 << ' ' << elem.second + 1 << '\n';
+    output += std::to_string(elem.first + 1);
+    output += ' ';
+    output += std::to_string(elem.second + 1);
+    output += '\n';
   }
+  std::cout << output;
 
   return 0;
 }
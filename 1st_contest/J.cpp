@@ -1,135 +1,162 @@
+#include <algorithm>
 #include <array>
+#include <cstdint>
 #include <iostream>
-#include <memory>
-#include <queue>
+#include <optional>
 #include <string>
-#include <unordered_set>
+#include <utility>
 #include <vector>
 
+// nodes are renumbered in BFS order by BuildAutomaton, so links always point
+// to smaller ids and the complete goto table is filled in one forward pass
 struct Trie {
   static const size_t kAlphabetSize = 2;
   static const char kFirstChar = '0';
+  static constexpr uint32_t kRoot = 0;
+  static constexpr uint32_t kNone = UINT32_MAX;
 
-  struct Node {
-    std::array<std::unique_ptr<Node>, kAlphabetSize> children{};
-    std::array<Node*, kAlphabetSize> go{};
-    Node* link = nullptr;
-    Node* parent;
-    int parent_char;
-    bool is_terminal = false;
-
-    Node(int p_ch, Node* p) : parent_char(p_ch), parent(p) { go.fill(nullptr); }
-  };
-
-  Trie() : root_(std::make_unique<Node>(-1, nullptr)) {}
+  Trie() { AddNode(0); }
 
   void AddString(const std::string& str) {
-    Node* current = root_.get();
+    uint32_t current = kRoot;
     for (char character : str) {
       size_t index = character - kFirstChar;
-      if (!current->children[index]) {
-        current->children[index] = std::make_unique<Node>(index, current);
+      if (go_[current][index] == kNone) {
+        uint32_t node = AddNode(depth_[current] + 1);
+        go_[current][index] = node;
       }
-      current = current->children[index].get();
+      current = go_[current][index];
     }
-    current->is_terminal = true;
+    is_terminal_[current] = true;
   }
 
+  // before BuildAutomaton only trie edges exist, after it an edge is a trie
+  // edge iff it goes one level deeper
   bool Find(const std::string& str) const {
-    const Node* current = root_.get();
+    uint32_t current = kRoot;
     for (char character : str) {
       size_t index = character - kFirstChar;
-      if (!current->children[index]) {
+      uint32_t next = go_[current][index];
+      if (next == kNone || depth_[next] != depth_[current] + 1) {
         return false;
       }
-      current = current->children[index].get();
+      current = next;
     }
-    return current->is_terminal;
+    return is_terminal_[current];
   }
 
   void BuildAutomaton() {
-    std::queue<Node*> queue;
-    root_->link = root_.get();
-
-    for (size_t i = 0; i < kAlphabetSize; ++i) {
-      if (root_->children[i]) {
-        root_->children[i]->link = root_.get();
-        queue.push(root_->children[i].get());
-      }
-    }
-
-    while (!queue.empty()) {
-      Node* node_ptr = queue.front();
-      queue.pop();
+    RenumberInBFSOrder();
 
+    link_.assign(go_.size(), kRoot);
 
-	  // ANCHOR : MarkBadNodes()	
-      if (node_ptr->link->is_terminal) {
-        node_ptr->is_terminal = true;
+    for (uint32_t node = 0; node < go_.size(); ++node) {
+      // ANCHOR : MarkBadNodes()
+      if (node != kRoot && is_terminal_[link_[node]]) {
+        is_terminal_[node] = true;
       }
 
       for (size_t i = 0; i < kAlphabetSize; ++i) {
-        if (node_ptr->children[i]) {
-          Node* u = node_ptr->children[i].get();
-          u->link = Go(node_ptr->link, i);
-          queue.push(u);
+        uint32_t fallback = (node == kRoot) ? kRoot : go_[link_[node]][i];
+        if (go_[node][i] != kNone) {
+          link_[go_[node][i]] = fallback;
+        } else {
+          go_[node][i] = fallback;
         }
       }
     }
   }
 
-  Node* Link(Node* node_ptr) {
-    if (node_ptr->link == nullptr) {
-      node_ptr->link =
-          (node_ptr == root_.get() || node_ptr->parent == root_.get())
-              ? root_.get()
-              : Go(Link(node_ptr->parent), node_ptr->parent_char);
-    }
-    return node_ptr->link;
-  }
+  bool HasSafeCycle() const { return !GetLongestSafeLength().has_value(); }
+
+  // length of the longest string containing no pattern, std::nullopt if
+  // they are arbitrarily long, i.e. a cycle over safe nodes is reachable;
+  // iterative three-color DFS, gray nodes are exactly the ones on the stack
+  std::optional<uint32_t> GetLongestSafeLength() const {
+    std::vector<bool> is_gray(go_.size(), false);
+    std::vector<bool> is_black(go_.size(), false);
+    // longest[v] - longest safe path from v, valid once v is black
+    std::vector<uint32_t> longest(go_.size(), 0);
+
+    // (node, next edge to try)
+    std::vector<std::pair<uint32_t, uint32_t>> stack = {{kRoot, 0}};
+    is_gray[kRoot] = true;
+
+    while (!stack.empty()) {
+      uint32_t node = stack.back().first;
+      uint32_t edge = stack.back().second;
+
+      if (edge == kAlphabetSize) {
+        stack.pop_back();
+        is_gray[node] = false;
+        is_black[node] = true;
+        if (!stack.empty()) {
+          uint32_t parent = stack.back().first;
+          longest[parent] = std::max(longest[parent], longest[node] + 1);
+        }
+        continue;
+      }
 
-  Node* Go(Node* node_ptr, size_t added_char) {
-    if (node_ptr->go[added_char] == nullptr) {
-      node_ptr->go[added_char] =
-          node_ptr->children[added_char]
-              ? node_ptr->children[added_char].get()
-              : (node_ptr == root_.get() ? root_.get()
-                                         : Go(Link(node_ptr), added_char));
+      ++stack.back().second;
+      uint32_t next = go_[node][edge];
+      if (is_terminal_[next]) {
+        continue;
+      }
+      if (is_gray[next]) {
+        return std::nullopt;
+      }
+      if (is_black[next]) {
+        longest[node] = std::max(longest[node], longest[next] + 1);
+      } else {
+        is_gray[next] = true;
+        stack.emplace_back(next, 0);
+      }
     }
-    return node_ptr->go[added_char];
-  }
 
-  std::unique_ptr<Node> root_;
-
-  bool HasSafeCycle() {
-    std::unordered_set<Node*> visited;
-    std::unordered_set<Node*> current_path_stack;
+    return longest[kRoot];
+  }
 
-    return DfsRecursive(root_.get(), visited, current_path_stack);
+ private:
+  std::vector<std::array<uint32_t, kAlphabetSize>> go_;
+  std::vector<uint32_t> link_;
+  std::vector<uint32_t> depth_;
+  std::vector<bool> is_terminal_;
+
+  uint32_t AddNode(uint32_t depth) {
+    go_.emplace_back();
+    go_.back().fill(kNone);
+    depth_.push_back(depth);
+    is_terminal_.push_back(false);
+    return go_.size() - 1;
   }
 
-  bool DfsRecursive(Node* node_ptr, std::unordered_set<Node*>& visited,
-                    std::unordered_set<Node*>& current_path_stack) {
-    if (current_path_stack.count(node_ptr)) {
-      return true;
-    }
-    if (visited.count(node_ptr)) {
-      return false;
+  void RenumberInBFSOrder() {
+    std::vector<uint32_t> order = {kRoot};
+    std::vector<uint32_t> new_id(go_.size(), kNone);
+    new_id[kRoot] = 0;
+    for (size_t head = 0; head < order.size(); ++head) {
+      for (uint32_t child : go_[order[head]]) {
+        if (child != kNone) {
+          new_id[child] = order.size();
+          order.push_back(child);
+        }
+      }
     }
 
-    visited.insert(node_ptr);
-    current_path_stack.insert(node_ptr);
-
-    for (size_t i = 0; i < kAlphabetSize; ++i) {
-      Node* next_node = Go(node_ptr, i);
-      if (!next_node->is_terminal &&
-          DfsRecursive(next_node, visited, current_path_stack)) {
-        return true;
+    std::vector<std::array<uint32_t, kAlphabetSize>> go(go_.size());
+    std::vector<uint32_t> depth(go_.size());
+    std::vector<bool> is_terminal(go_.size());
+    for (uint32_t old_id = 0; old_id < go_.size(); ++old_id) {
+      uint32_t node = new_id[old_id];
+      for (size_t i = 0; i < kAlphabetSize; ++i) {
+        go[node][i] = (go_[old_id][i] == kNone) ? kNone : new_id[go_[old_id][i]];
       }
+      depth[node] = depth_[old_id];
+      is_terminal[node] = is_terminal_[old_id];
     }
-
-    current_path_stack.erase(node_ptr);
-    return false;
+    go_ = std::move(go);
+    depth_ = std::move(depth);
+    is_terminal_ = std::move(is_terminal);
   }
 };
 
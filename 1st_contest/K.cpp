@@ -1,143 +1,271 @@
+#include <algorithm>
 #include <array>
+#include <chrono>
+#include <cstdint>
 #include <iostream>
-#include <memory>
-#include <queue>
+#include <random>
 #include <string>
+#include <thread>
 #include <vector>
 
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+struct PatternMatch {
+  size_t position;
+  uint32_t id;
+};
+
+// nodes are renumbered in BFS order by BuildAutomaton, so links always point
+// to smaller ids and the complete goto table is filled in one forward pass
 struct AhoKorasikTrie {
   static const size_t kAlphabetSize = 26;
   static const char kFirstChar = 'a';
+  static constexpr uint32_t kRoot = 0;
+  static constexpr uint32_t kNone = UINT32_MAX;
 
-  AhoKorasikTrie() : root_(std::make_unique<Node>(-1, nullptr)), str_count(0) {}
+  AhoKorasikTrie() { AddNode(0); }
 
   void AddString(const std::string& str) {
-    Node* current = root_.get();
+    uint32_t current = kRoot;
     for (char character : str) {
       size_t index = character - kFirstChar;
-      if (!current->children[index]) {
-        current->children[index] = std::make_unique<Node>(index, current);
+      if (go_[current][index] == kNone) {
+        uint32_t node = AddNode(depth_[current] + 1);
+        go_[current][index] = node;
       }
-      current = current->children[index].get();
+      current = go_[current][index];
     }
-    current->is_terminal = true;
-    current->length = str.size();
-    current->ids.push_back(str_count++);
+    is_terminal_[current] = true;
+    string_nodes_.push_back(current);
   }
 
+  // before BuildAutomaton only trie edges exist, after it an edge is a trie
+  // edge iff it goes one level deeper
   bool Find(const std::string& str) const {
-    const Node* current = root_.get();
+    uint32_t current = kRoot;
     for (char character : str) {
       size_t index = character - kFirstChar;
-      if (!current->children[index]) {
+      uint32_t next = go_[current][index];
+      if (next == kNone || depth_[next] != depth_[current] + 1) {
         return false;
       }
-      current = current->children[index].get();
+      current = next;
     }
-    return current->is_terminal;
+    return is_terminal_[current];
   }
 
   void BuildAutomaton() {
-    std::queue<Node*> queue;
-    root_->link = root_.get();
+    RenumberInBFSOrder();
 
-    for (size_t i = 0; i < kAlphabetSize; ++i) {
-      if (root_->children[i]) {
-        Node* child = root_->children[i].get();
-        child->link = root_.get();
-        queue.push(child);
-      }
-    }
-
-    while (!queue.empty()) {
-      Node* node_ptr = queue.front();
-      queue.pop();
+    link_.assign(go_.size(), kRoot);
+    dictionary_link_.assign(go_.size(), kNone);
+    has_output_.assign(go_.size(), false);
 
+    for (uint32_t node = 0; node < go_.size(); ++node) {
+      if (node != kRoot) {
+        uint32_t link = link_[node];
+        dictionary_link_[node] =
+            is_terminal_[link] ? link : dictionary_link_[link];
+      }
+      has_output_[node] = is_terminal_[node] || dictionary_link_[node] != kNone;
       for (size_t i = 0; i < kAlphabetSize; ++i) {
-        if (node_ptr->children[i]) {
-          Node* u = node_ptr->children[i].get();
-          u->link = Go(node_ptr->link, i);
-          queue.push(u);
+        uint32_t fallback = (node == kRoot) ? kRoot : go_[link_[node]][i];
+        if (go_[node][i] != kNone) {
+          link_[go_[node][i]] = fallback;
+        } else {
+          go_[node][i] = fallback;
         }
       }
     }
   }
 
-  std::vector<size_t> CountMaskSubstringsOccurences(
-      const std::string& text, const std::vector<size_t>& substr_positions) {
-    std::vector<size_t> result(text.size() + 1);
-    Node* node_ptr = root_.get();
+  // number of text positions where at least one pattern ends
+  size_t CountMatchingPositions(const std::string& text) const {
+    size_t result = 0;
+    uint32_t node = kRoot;
+    for (char character : text) {
+      size_t index = character - kFirstChar;
+      node = (index < kAlphabetSize) ? go_[node][index] : kRoot;
+      result += has_output_[node] ? 1 : 0;
+    }
+    return result;
+  }
 
-    for (size_t i = 0; i < text.size(); ++i) {
-      char character = text[i];
+  // occurrences of every added string in order of addition: hits are
+  // counted per node during the scan and pushed up the link tree afterwards,
+  // children come after parents in BFS order
+  std::vector<size_t> CountPatternOccurrences(const std::string& text) const {
+    std::vector<size_t> hits(go_.size(), 0);
+    uint32_t node = kRoot;
+    for (char character : text) {
       size_t index = character - kFirstChar;
+      node = (index < kAlphabetSize) ? go_[node][index] : kRoot;
+      ++hits[node];
+    }
 
-      if (index >= kAlphabetSize) {
-        node_ptr = root_.get();
-        continue;
-      }
-
-      node_ptr = Go(node_ptr, index);
-
-      Node* temp = node_ptr;
-      while (temp != nullptr && temp != root_.get()) {
-        if (temp->is_terminal) {
-          for (size_t id : temp->ids) {
-            size_t pos = i - temp->length + 1;
-            if (pos <= i) {
-              if (pos + 1 < substr_positions[id]) {
-                continue;
-              }
-              ++result[pos - substr_positions[id] + 1];
-            }
-          }
-        }
-        temp = temp->link;
+    for (uint32_t node = go_.size() - 1; node > kRoot; --node) {
+      hits[link_[node]] += hits[node];
+    }
+
+    std::vector<size_t> result(string_nodes_.size());
+    for (size_t id = 0; id < string_nodes_.size(); ++id) {
+      result[id] = hits[string_nodes_[id]];
+    }
+    return result;
+  }
+
+  size_t GetMaxDepth() const { return max_depth_; }
+
+  uint32_t Advance(uint32_t node, char character) const {
+    size_t index = character - kFirstChar;
+    return (index < kAlphabetSize) ? go_[node][index] : kRoot;
+  }
+
+  // on_match(length, id) for every string ending at node; only terminal
+  // nodes are visited, O(1 + matches)
+  template <typename OnMatch>
+  void ForEachMatch(uint32_t node, OnMatch&& on_match) const {
+    for (uint32_t temp = is_terminal_[node] ? node : dictionary_link_[node];
+         temp != kNone; temp = dictionary_link_[temp]) {
+      for (uint32_t it = ids_begin_[temp]; it < ids_begin_[temp + 1]; ++it) {
+        on_match(depth_[temp], ids_[it]);
       }
     }
+  }
+
+  // on_match(position, id) for every match ending in text[begin..end); the
+  // scan starts max depth - 1 bytes before begin, which is enough for the
+  // state at begin to see every match that ends there, const and thread-safe
+  template <typename OnMatch>
+  void ScanChunk(const std::string& text, size_t begin, size_t end,
+                 OnMatch&& on_match) const {
+    size_t warm_up = (max_depth_ > 0) ? max_depth_ - 1 : 0;
+    uint32_t node = kRoot;
+
+    for (size_t i = (begin > warm_up) ? begin - warm_up : 0; i < begin; ++i) {
+      node = Advance(node, text[i]);
+    }
+    for (size_t i = begin; i < end; ++i) {
+      node = Advance(node, text[i]);
+      ForEachMatch(node, [&](uint32_t length, uint32_t id) {
+        on_match(i + 1 - length, id);
+      });
+    }
+  }
 
+  std::vector<size_t> CountMaskSubstringsOccurences(
+      const std::string& text, const std::vector<size_t>& substr_positions) const {
+    std::vector<size_t> result(text.size() + 1);
+    ScanChunk(text, 0, text.size(), [&](size_t pos, uint32_t id) {
+      if (pos + 1 >= substr_positions[id]) {
+        ++result[pos - substr_positions[id] + 1];
+      }
+    });
     return result;
   }
 
  private:
-  struct Node {
-    std::array<std::unique_ptr<Node>, kAlphabetSize> children{};
-    std::array<Node*, kAlphabetSize> go{};
-    Node* link = nullptr;
-    Node* parent;
-    int parent_char;
-    bool is_terminal = false;
-    size_t length = 0;
-    std::vector<size_t> ids{};
-
-    Node(int p_ch, Node* p) : parent_char(p_ch), parent(p) { go.fill(nullptr); }
-  };
+  std::vector<std::array<uint32_t, kAlphabetSize>> go_;
+  std::vector<uint32_t> link_;
+  std::vector<uint32_t> depth_;
+  uint32_t max_depth_ = 0;
+  std::vector<bool> is_terminal_;
+  // nearest terminal node on the suffix link chain, excluding the node itself
+  std::vector<uint32_t> dictionary_link_;
+  // some string ends at the node, itself or through links
+  std::vector<bool> has_output_;
 
-  std::unique_ptr<Node> root_;
-  size_t str_count = 0;
+  // ids of the strings ending at a node: ids_[ids_begin_[v]..ids_begin_[v + 1])
+  std::vector<uint32_t> string_nodes_;
+  std::vector<uint32_t> ids_begin_;
+  std::vector<uint32_t> ids_;
 
-  Node* Link(Node* node_ptr) {
-    if (node_ptr->link == nullptr) {
-      node_ptr->link =
-          (node_ptr == root_.get() || node_ptr->parent == root_.get())
-              ? root_.get()
-              : Go(Link(node_ptr->parent), node_ptr->parent_char);
-    }
-    return node_ptr->link;
+  uint32_t AddNode(uint32_t depth) {
+    go_.emplace_back();
+    go_.back().fill(kNone);
+    depth_.push_back(depth);
+    max_depth_ = std::max(max_depth_, depth);
+    is_terminal_.push_back(false);
+    return go_.size() - 1;
   }
 
-  Node* Go(Node* node_ptr, size_t added_char) {
-    if (node_ptr->go[added_char] == nullptr) {
-      node_ptr->go[added_char] =
-          node_ptr->children[added_char]
-              ? node_ptr->children[added_char].get()
-              : (node_ptr == root_.get() ? root_.get()
-                                         : Go(Link(node_ptr), added_char));
+  void RenumberInBFSOrder() {
+    std::vector<uint32_t> order = {kRoot};
+    std::vector<uint32_t> new_id(go_.size(), kNone);
+    new_id[kRoot] = 0;
+    for (size_t head = 0; head < order.size(); ++head) {
+      for (uint32_t child : go_[order[head]]) {
+        if (child != kNone) {
+          new_id[child] = order.size();
+          order.push_back(child);
+        }
+      }
+    }
+
+    std::vector<std::array<uint32_t, kAlphabetSize>> go(go_.size());
+    std::vector<uint32_t> depth(go_.size());
+    std::vector<bool> is_terminal(go_.size());
+    for (uint32_t old_id = 0; old_id < go_.size(); ++old_id) {
+      uint32_t node = new_id[old_id];
+      for (size_t i = 0; i < kAlphabetSize; ++i) {
+        go[node][i] = (go_[old_id][i] == kNone) ? kNone : new_id[go_[old_id][i]];
+      }
+      depth[node] = depth_[old_id];
+      is_terminal[node] = is_terminal_[old_id];
+    }
+    go_ = std::move(go);
+    depth_ = std::move(depth);
+    is_terminal_ = std::move(is_terminal);
+
+    ids_begin_.assign(go_.size() + 1, 0);
+    for (uint32_t& node : string_nodes_) {
+      node = new_id[node];
+      ++ids_begin_[node + 1];
+    }
+    for (size_t node = 0; node < go_.size(); ++node) {
+      ids_begin_[node + 1] += ids_begin_[node];
+    }
+    ids_.resize(string_nodes_.size());
+    std::vector<uint32_t> fill(ids_begin_.begin(), ids_begin_.end() - 1);
+    for (uint32_t id = 0; id < string_nodes_.size(); ++id) {
+      ids_[fill[string_nodes_[id]]++] = id;
     }
-    return node_ptr->go[added_char];
   }
 };
 
+// matches ordered by end position, longer first; the text is split into one
+// chunk of end positions per thread, each thread fills its own buffer and
+// the automaton is shared read-only
+std::vector<PatternMatch> FindPatternMatches(const AhoKorasikTrie& trie,
+                                             const std::string& text,
+                                             size_t thread_count) {
+  thread_count = std::max<size_t>(1, std::min(thread_count, text.size()));
+  size_t chunk_size = (text.size() + thread_count - 1) / thread_count;
+
+  std::vector<std::vector<PatternMatch>> chunk_matches(thread_count);
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < thread_count; ++t) {
+    size_t begin = std::min(text.size(), t * chunk_size);
+    size_t end = std::min(text.size(), begin + chunk_size);
+    threads.emplace_back([&, t, begin, end] {
+      trie.ScanChunk(text, begin, end, [&](size_t position, uint32_t id) {
+        chunk_matches[t].push_back({position, id});
+      });
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  std::vector<PatternMatch> matches;
+  for (const auto& chunk : chunk_matches) {
+    matches.insert(matches.end(), chunk.begin(), chunk.end());
+  }
+  return matches;
+}
+
 void GetMaskSubstrings(const std::string& mask,
                        std::vector<std::string>& substrings,
                        std::vector<size_t>& substr_positions) {
@@ -159,7 +287,8 @@ void GetMaskSubstrings(const std::string& mask,
   }
 }
 
-void FindAllMaskOccurences(const std::string& mask, const std::string& text) {
+std::vector<size_t> FindMaskOccurrencesAhoKorasik(const std::string& mask,
+                                                  const std::string& text) {
   std::vector<std::string> substrings;
   std::vector<size_t> substr_positions;
   GetMaskSubstrings(mask, substrings, substr_positions);
@@ -173,16 +302,306 @@ void FindAllMaskOccurences(const std::string& mask, const std::string& text) {
   auto mask_substr_occurences =
       trie.CountMaskSubstringsOccurences(text, substr_positions);
 
+  std::vector<size_t> occurrences;
   for (int i = 1;
        i <= static_cast<int>(text.size()) - static_cast<int>(mask.size()) + 1;
        ++i) {
     if (mask_substr_occurences[i] == substrings.size()) {
-      std::cout << i - 1 << " ";
+      occurrences.push_back(i - 1);
+    }
+  }
+  return occurrences;
+}
+
+// Shift-And over kWords 64-bit words: bit j of the state is set iff
+// mask[0..j] matches the text ending at the current byte, '?' bits are set
+// in every row of the table; one shift, or and and per byte, no branches
+// on the mask
+template <size_t kWords>
+class ShiftAndMatcher {
+ public:
+  static const size_t kMaxMaskSize = 64 * kWords;
+
+  explicit ShiftAndMatcher(const std::string& mask) : mask_size_(mask.size()) {
+    std::array<uint64_t, kWords> wildcards = {};
+    for (size_t j = 0; j < mask.size(); ++j) {
+      if (mask[j] == '?') {
+        wildcards[j / 64] |= uint64_t{1} << (j % 64);
+      }
+    }
+    table_.fill(wildcards);
+    for (size_t j = 0; j < mask.size(); ++j) {
+      if (mask[j] != '?') {
+        table_[static_cast<uint8_t>(mask[j])][j / 64] |= uint64_t{1} << (j % 64);
+      }
+    }
+  }
+
+  // mask_size_ must be in [1, kMaxMaskSize]
+  std::vector<size_t> FindOccurrences(const std::string& text) const {
+    std::vector<size_t> occurrences;
+    std::array<uint64_t, kWords> match_bits = {};
+    match_bits[(mask_size_ - 1) / 64] = uint64_t{1} << ((mask_size_ - 1) % 64);
+
+#if defined(__AVX2__)
+    if constexpr (kWords == 4) {
+      __m256i match =
+          _mm256_loadu_si256(reinterpret_cast<const __m256i*>(match_bits.data()));
+      const __m256i first_bit = _mm256_setr_epi64x(1, 0, 0, 0);
+      __m256i state = _mm256_setzero_si256();
+
+      for (size_t i = 0; i < text.size(); ++i) {
+        // lane k takes the top bit of lane k - 1, lane 0 takes the new 1
+        __m256i carry = _mm256_permute4x64_epi64(_mm256_srli_epi64(state, 63),
+                                                 _MM_SHUFFLE(2, 1, 0, 3));
+        carry = _mm256_blend_epi32(carry, first_bit, 0b00000011);
+        __m256i row = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(
+            table_[static_cast<uint8_t>(text[i])].data()));
+        state = _mm256_and_si256(
+            _mm256_or_si256(_mm256_slli_epi64(state, 1), carry), row);
+        if (!_mm256_testz_si256(state, match)) {
+          occurrences.push_back(i + 1 - mask_size_);
+        }
+      }
+      return occurrences;
+    }
+#endif
+
+    std::array<uint64_t, kWords> state = {};
+    for (size_t i = 0; i < text.size(); ++i) {
+      const auto& row = table_[static_cast<uint8_t>(text[i])];
+#pragma GCC unroll 4
+      for (size_t w = kWords - 1; w > 0; --w) {
+        state[w] = ((state[w] << 1) | (state[w - 1] >> 63)) & row[w];
+      }
+      state[0] = ((state[0] << 1) | 1) & row[0];
+
+      // no indexing by a runtime word, the state stays in registers
+      uint64_t match = 0;
+#pragma GCC unroll 4
+      for (size_t w = 0; w < kWords; ++w) {
+        match |= state[w] & match_bits[w];
+      }
+      if (match != 0) {
+        occurrences.push_back(i + 1 - mask_size_);
+      }
     }
+    return occurrences;
+  }
+
+ private:
+  size_t mask_size_;
+  std::array<std::array<uint64_t, kWords>, 256> table_;
+};
+
+// bit-parallel engine for masks up to 256 characters, Aho-Corasick beyond
+std::vector<size_t> FindMaskOccurrences(const std::string& mask,
+                                        const std::string& text) {
+  if (mask.empty() || mask.size() > ShiftAndMatcher<4>::kMaxMaskSize) {
+    return FindMaskOccurrencesAhoKorasik(mask, text);
+  }
+  if (mask.size() <= ShiftAndMatcher<1>::kMaxMaskSize) {
+    return ShiftAndMatcher<1>(mask).FindOccurrences(text);
+  }
+  if (mask.size() <= ShiftAndMatcher<2>::kMaxMaskSize) {
+    return ShiftAndMatcher<2>(mask).FindOccurrences(text);
+  }
+  return ShiftAndMatcher<4>(mask).FindOccurrences(text);
+}
+
+void FindAllMaskOccurences(const std::string& mask, const std::string& text) {
+  for (size_t position : FindMaskOccurrences(mask, text)) {
+    std::cout << position << " ";
   }
   std::cout << "\n";
 }
 
+// many masks against one text: a single automaton over the fragments of all
+// masks, every fragment id carries (mask, offset in the mask); counters live
+// in per-mask rings indexed by start position, a slot is reused once its
+// start falls out of the window, which the stored start detects
+class MultiMaskMatcher {
+ public:
+  explicit MultiMaskMatcher(const std::vector<std::string>& masks)
+      : mask_sizes_(masks.size()), fragment_counts_(masks.size()) {
+    size_t max_mask_size = 1;
+    for (uint32_t mask_id = 0; mask_id < masks.size(); ++mask_id) {
+      std::vector<std::string> substrings;
+      std::vector<size_t> substr_positions;
+      GetMaskSubstrings(masks[mask_id], substrings, substr_positions);
+
+      for (size_t i = 0; i < substrings.size(); ++i) {
+        trie_.AddString(substrings[i]);
+        fragment_masks_.push_back(mask_id);
+        fragment_offsets_.push_back(substr_positions[i]);
+      }
+      mask_sizes_[mask_id] = masks[mask_id].size();
+      fragment_counts_[mask_id] = substrings.size();
+      max_mask_size = std::max(max_mask_size, masks[mask_id].size());
+    }
+    trie_.BuildAutomaton();
+
+    while (ring_size_ < max_mask_size) {
+      ring_size_ <<= 1;
+    }
+  }
+
+  // sorted start positions of every mask, one pass over the text
+  std::vector<std::vector<size_t>> FindOccurrences(const std::string& text) const {
+    std::vector<std::vector<size_t>> occurrences(mask_sizes_.size());
+    std::vector<Slot> slots(mask_sizes_.size() * ring_size_, {kNoStart, 0});
+
+    trie_.ScanChunk(text, 0, text.size(), [&](size_t position, uint32_t id) {
+      uint32_t mask_id = fragment_masks_[id];
+      size_t offset = fragment_offsets_[id];
+      if (position < offset) {
+        return;
+      }
+      size_t start = position - offset;
+      if (start + mask_sizes_[mask_id] > text.size()) {
+        return;
+      }
+
+      Slot& slot = slots[mask_id * ring_size_ + (start & (ring_size_ - 1))];
+      if (slot.start != start) {
+        slot = {start, 0};
+      }
+      // the fragment with the largest offset completes the count last, so
+      // every mask gets its starts in increasing order
+      if (++slot.count == fragment_counts_[mask_id]) {
+        occurrences[mask_id].push_back(start);
+      }
+    });
+
+    // masks of '?' only match everywhere
+    for (size_t mask_id = 0; mask_id < mask_sizes_.size(); ++mask_id) {
+      if (fragment_counts_[mask_id] == 0) {
+        for (size_t start = 0; start + mask_sizes_[mask_id] <= text.size();
+             ++start) {
+          occurrences[mask_id].push_back(start);
+        }
+      }
+    }
+
+    return occurrences;
+  }
+
+ private:
+  static constexpr size_t kNoStart = SIZE_MAX;
+
+  struct Slot {
+    size_t start;
+    uint32_t count;
+  };
+
+  AhoKorasikTrie trie_;
+  std::vector<uint32_t> fragment_masks_;
+  std::vector<size_t> fragment_offsets_;
+  std::vector<size_t> mask_sizes_;
+  std::vector<uint32_t> fragment_counts_;
+  // power of two, at least the longest mask
+  size_t ring_size_ = 1;
+};
+
+// one mask over a stream read in buffers: counters for the |mask| starts
+// whose window is still open sit in a ring, the window of start p is
+// complete after byte p + |mask| - 1 and its slot is cleared for p + |mask|;
+// memory is O(|mask| + trie) whatever the stream length
+class StreamingMaskMatcher {
+ public:
+  explicit StreamingMaskMatcher(const std::string& mask)
+      : mask_size_(mask.size()), window_(mask.size(), 0) {
+    std::vector<std::string> substrings;
+    std::vector<size_t> substr_positions;
+    GetMaskSubstrings(mask, substrings, substr_positions);
+
+    for (size_t i = 0; i < substrings.size(); ++i) {
+      trie_.AddString(substrings[i]);
+      // end of the fragment inside the mask
+      fragment_ends_.push_back(substr_positions[i] + substrings[i].size());
+    }
+    fragment_count_ = substrings.size();
+    trie_.BuildAutomaton();
+  }
+
+  // on_match(start) gets the absolute stream offset of every occurrence,
+  // in increasing order
+  template <typename OnMatch>
+  void Feed(const char* data, size_t size, OnMatch&& on_match) {
+    if (mask_size_ == 0) {
+      return;
+    }
+
+    for (size_t i = 0; i < size; ++i) {
+      uint64_t end = offset_ + i + 1;
+      node_ = trie_.Advance(node_, data[i]);
+      trie_.ForEachMatch(node_, [&](uint32_t, uint32_t id) {
+        if (end >= fragment_ends_[id]) {
+          ++window_[(end - fragment_ends_[id]) % mask_size_];
+        }
+      });
+
+      if (end >= mask_size_) {
+        uint64_t start = end - mask_size_;
+        uint32_t& count = window_[start % mask_size_];
+        if (count == fragment_count_) {
+          on_match(start);
+        }
+        count = 0;
+      }
+    }
+    offset_ += size;
+  }
+
+ private:
+  size_t mask_size_;
+  AhoKorasikTrie trie_;
+  std::vector<size_t> fragment_ends_;
+  uint32_t fragment_count_ = 0;
+
+  uint32_t node_ = AhoKorasikTrie::kRoot;
+  uint64_t offset_ = 0;
+  // window_[p % |mask|] - fragments found so far for start p
+  std::vector<uint32_t> window_;
+};
+
+// throughput in GB/s over random text for random patterns: the count-only
+// scan, then FindPatternMatches for 1, 2, 4, ..., max_threads threads
+void BenchmarkScan(size_t text_size, size_t pattern_count, size_t pattern_size,
+                   size_t max_threads) {
+  std::mt19937 generator(42);
+  auto random_string = [&](size_t size) {
+    std::string str(size, 'a');
+    for (char& character : str) {
+      character = AhoKorasikTrie::kFirstChar +
+                  generator() % AhoKorasikTrie::kAlphabetSize;
+    }
+    return str;
+  };
+
+  AhoKorasikTrie trie;
+  for (size_t i = 0; i < pattern_count; ++i) {
+    trie.AddString(random_string(pattern_size));
+  }
+  trie.BuildAutomaton();
+  std::string text = random_string(text_size);
+
+  auto start = std::chrono::steady_clock::now();
+  size_t positions = trie.CountMatchingPositions(text);
+  std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+  std::cout << "count only: " << text_size / elapsed.count() / 1e9
+            << " GB/s, " << positions << " matching positions\n";
+
+  for (size_t threads = 1; threads <= max_threads; threads *= 2) {
+    start = std::chrono::steady_clock::now();
+    size_t matches = FindPatternMatches(trie, text, threads).size();
+    elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << threads << " threads: " << text_size / elapsed.count() / 1e9
+              << " GB/s, " << matches << " matches\n";
+  }
+}
+
 int main() {
   std::string mask;
   std::string text;
@@ -190,5 +609,8 @@ int main() {
 
   FindAllMaskOccurences(mask, text);
 
+  // BenchmarkScan(1'000'000'000, 10'000, 8,
+  //               std::thread::hardware_concurrency());
+
   return 0;
 }
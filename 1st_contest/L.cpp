@@ -1,53 +1,84 @@
 #include <algorithm>
+#include <cstdint>
 #include <iostream>
 #include <string>
 #include <vector>
 
-std::vector<int> manacher_odd(std::string s) {
-  std::vector<int> radius(s.size(), 1);
-  int left = 0;
-  int right = 0;
-  for (int i = 1; i < s.size(); ++i) {
-    if (i < right)
-      radius[i] = std::min(right - i + 1, radius[left + right - i]);
-    while (i - radius[i] >= 0 && i + radius[i] < s.size() &&
-           s[i - radius[i]] == s[i + radius[i]])
-      ++radius[i];
-    if (i + radius[i] - 1 > right)
-      left = i - radius[i] + 1, right = i + radius[i] - 1;
-  }
-  return radius;
-}
-
-int main() {
-  std::string s;
-  std::cin >> s;
+// odd_radius[i]  - number of odd palindromes centered at i
+// even_radius[i] - number of even palindromes centered between i - 1 and i
+class Manacher {
+ public:
+  explicit Manacher(const std::string& s)
+      : odd_radius_(s.size(), 0), even_radius_(s.size(), 0) {
+    int64_t n = s.size();
+    int64_t odd_left = 0;
+    int64_t odd_right = -1;
+    int64_t even_left = 0;
+    int64_t even_right = -1;
 
-  std::string s_trick;
+    for (int64_t i = 0; i < n; ++i) {
+      int64_t odd = (i > odd_right)
+                        ? 1
+                        : std::min(odd_radius_[odd_left + odd_right - i],
+                                   odd_right - i + 1);
+      while (i - odd >= 0 && i + odd < n && s[i - odd] == s[i + odd]) {
+        ++odd;
+      }
+      odd_radius_[i] = odd;
+      if (i + odd - 1 > odd_right) {
+        odd_left = i - odd + 1;
+        odd_right = i + odd - 1;
+      }
 
-  for (int i = 0; i < 2 * s.size() - 1; i++) {
-    if (i % 2 == 0) {
-      s_trick.push_back(s[i / 2]);
-    } else {
-      s_trick.push_back('#');
+      int64_t even = (i > even_right)
+                         ? 0
+                         : std::min(even_radius_[even_left + even_right - i + 1],
+                                    even_right - i + 1);
+      while (i - even - 1 >= 0 && i + even < n &&
+             s[i - even - 1] == s[i + even]) {
+        ++even;
+      }
+      even_radius_[i] = even;
+      if (i + even - 1 > even_right) {
+        even_left = i - even;
+        even_right = i + even - 1;
+      }
     }
   }
 
-  // std::cout << s_trick << "\n";
+  // s[l..r], O(1)
+  bool IsPalindrome(int64_t l, int64_t r) const {
+    int64_t length = r - l + 1;
+    if (length <= 0) {
+      return true;
+    }
+    if (length % 2 == 1) {
+      return odd_radius_[l + length / 2] >= (length + 1) / 2;
+    }
+    return even_radius_[l + length / 2] >= length / 2;
+  }
 
-  std::vector<int> radius = manacher_odd(s_trick);
-  int res = 0;
-  for (int i = 0; i < radius.size(); i++) {
-    // std::cout << radius[i] << " ";
-    if (i % 2 != 0) {
-      res += std::max(0, radius[i] / 2);
-    } else {
-      res += std::max(0, (radius[i] - 1) / 2);
+  // palindromic substrings of length at least 2
+  int64_t CountNonTrivialPalindromes() const {
+    int64_t result = 0;
+    for (size_t i = 0; i < odd_radius_.size(); ++i) {
+      result += odd_radius_[i] - 1 + even_radius_[i];
     }
+    return result;
   }
-  // std::cout << "\n";
 
-  std::cout << res << "\n";
+ private:
+  std::vector<int64_t> odd_radius_;
+  std::vector<int64_t> even_radius_;
+};
+
+int main() {
+  std::string s;
+  std::cin >> s;
+
+  Manacher manacher(s);
+
+  std::cout << manacher.CountNonTrivialPalindromes() << "\n";
 
   return 0;
 }
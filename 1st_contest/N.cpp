@@ -3,7 +3,6 @@
 #include <string>
 #include <vector>
 
-
 // indexation from 0
 std::vector<int> GetLCP(const std::string& str,
                         const std::vector<int>& suffix_array) {
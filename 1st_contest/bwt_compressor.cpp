@@ -0,0 +1,571 @@
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <iterator>
+#include <optional>
+#include <queue>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct Suffix {
+  int index;  // begin of the suffix in the string
+  int rank;   //
+  int next_rank;
+
+  bool operator<(const Suffix& other) const {
+    return (this->rank == other.rank)
+               ? (this->next_rank < other.next_rank ? 1 : 0)
+               : (this->rank < other.rank ? 1 : 0);
+  }
+};
+
+// indexation from 0
+std::vector<int> BuildSuffixArray(const std::string& str) {
+  size_t n = str.size();
+  if (n == 0) {
+    return {};
+  }
+  std::vector<Suffix> suffix_data(n);
+
+  // assigning ranks & next_ranks to suffixes
+  for (int i = 0; i < n; i++) {
+    suffix_data[i].index = i;
+    suffix_data[i].rank = static_cast<unsigned char>(str[i]);
+    suffix_data[i].next_rank =
+        ((i + 1) < n) ? static_cast<unsigned char>(str[i + 1]) : -1;
+  }
+
+  // sorting the suffixes according to first 2 characters
+  std::sort(suffix_data.begin(), suffix_data.end());
+
+  // sorting suffixes according to first 4, 8, ... characters
+  std::vector<int> suffixes_index(
+      n);  // index in suffix_data by index in string
+  for (int i = 4; i < 2 * n; i = i * 2) {
+    int rank = 0;
+    int prev_rank = suffix_data[0].rank;
+    suffix_data[0].rank = rank;
+    suffixes_index[suffix_data[0].index] = 0;
+
+    for (int j = 1; j < n; j++) {
+      if (suffix_data[j].rank == prev_rank &&
+          suffix_data[j].next_rank == suffix_data[j - 1].next_rank) {
+        prev_rank = suffix_data[j].rank;
+        suffix_data[j].rank = rank;
+      } else {
+        prev_rank = suffix_data[j].rank;
+        suffix_data[j].rank = ++rank;
+      }
+      suffixes_index[suffix_data[j].index] = j;
+    }
+
+    // Assign next rank to every Suffix
+    for (int j = 0; j < n; j++) {
+      int next_index = suffix_data[j].index + i / 2;
+      suffix_data[j].next_rank =
+          (next_index < n) ? suffix_data[suffixes_index[next_index]].rank : -1;
+    }
+
+    // sorting the suffixes according to first i characters
+    std::sort(suffix_data.begin(), suffix_data.end());
+  }
+
+  std::vector<int> suffix_array(n);
+  for (int i = 0; i < n; i++) {
+    suffix_array[i] = suffix_data[i].index;
+  }
+
+  return suffix_array;
+}
+
+const size_t kBlockSize = 900'000;
+const char kMagic[4] = {'B', 'W', 'T', '2'};
+
+// after move-to-front zero runs are written in bijective base 2 with
+// kRunA = 1, kRunB = 2 (as in bzip2), other ranks v as v + 1
+const int kRunA = 0;
+const int kRunB = 1;
+const int kEndOfBlock = 257;
+const int kSymbolCount = 258;
+const int kMaxCodeLength = 20;
+
+// bwt of str + '$' without the sentinel, primary_index - row of the '$'
+std::string ComputeBWT(const std::string& block, uint32_t& primary_index) {
+  std::vector<int> suffix_array = BuildSuffixArray(block);
+  std::string bwt;
+  bwt.reserve(block.size());
+
+  // row 0 is the rotation starting with '$'
+  bwt.push_back(block.back());
+  for (size_t rank = 0; rank < suffix_array.size(); ++rank) {
+    if (suffix_array[rank] == 0) {
+      primary_index = rank + 1;
+    } else {
+      bwt.push_back(block[suffix_array[rank] - 1]);
+    }
+  }
+  return bwt;
+}
+
+// LF-mapping walk from the '$' row backwards through the text
+std::string InvertBWT(const std::string& bwt, uint32_t primary_index) {
+  size_t n = bwt.size();
+  std::array<uint32_t, 257> first_row{};  // '$' is counted as the smallest
+  for (char character : bwt) {
+    ++first_row[static_cast<uint8_t>(character) + 1];
+  }
+  first_row[0] = 1;
+  for (size_t c = 1; c < first_row.size(); ++c) {
+    first_row[c] += first_row[c - 1];
+  }
+
+  // lf[row], the '$' row is skipped in bwt indexing
+  std::vector<uint32_t> lf(n + 1, 0);
+  std::array<uint32_t, 256> seen{};
+  for (size_t row = 0, i = 0; row <= n; ++row) {
+    if (row == primary_index) {
+      continue;
+    }
+    uint8_t character = bwt[i++];
+    lf[row] = first_row[character] + seen[character]++;
+  }
+
+  std::string block(n, '\0');
+  for (size_t row = 0, k = n; k > 0; --k) {
+    block[k - 1] = bwt[row < primary_index ? row : row - 1];
+    row = lf[row];
+  }
+  return block;
+}
+
+std::vector<uint16_t> EncodeMoveToFront(const std::string& bwt) {
+  std::array<uint8_t, 256> order;
+  for (int i = 0; i < 256; ++i) {
+    order[i] = i;
+  }
+
+  std::vector<uint16_t> symbols;
+  uint32_t zero_run = 0;
+  auto flush_run = [&] {
+    while (zero_run > 0) {
+      if (zero_run & 1) {
+        symbols.push_back(kRunA);
+        zero_run = (zero_run - 1) / 2;
+      } else {
+        symbols.push_back(kRunB);
+        zero_run = (zero_run - 2) / 2;
+      }
+    }
+  };
+
+  for (char character : bwt) {
+    uint8_t byte = character;
+    int rank = 0;
+    while (order[rank] != byte) {
+      ++rank;
+    }
+    if (rank == 0) {
+      ++zero_run;
+      continue;
+    }
+    flush_run();
+    std::memmove(order.data() + 1, order.data(), rank);
+    order[0] = byte;
+    symbols.push_back(rank + 1);
+  }
+  flush_run();
+  symbols.push_back(kEndOfBlock);
+  return symbols;
+}
+
+// std::nullopt if the output would exceed max_size
+std::optional<std::string> DecodeMoveToFront(
+    const std::vector<uint16_t>& symbols, size_t max_size) {
+  std::array<uint8_t, 256> order;
+  for (int i = 0; i < 256; ++i) {
+    order[i] = i;
+  }
+
+  std::string bwt;
+  uint64_t zero_run = 0;
+  uint64_t weight = 1;
+  for (uint16_t symbol : symbols) {
+    if (symbol == kRunA || symbol == kRunB) {
+      zero_run += (symbol == kRunA ? 1 : 2) * weight;
+      weight <<= 1;
+      if (zero_run > max_size - bwt.size()) {
+        return std::nullopt;
+      }
+      continue;
+    }
+    if (zero_run + (symbol == kEndOfBlock ? 0 : 1) > max_size - bwt.size()) {
+      return std::nullopt;
+    }
+    bwt.append(zero_run, order[0]);
+    zero_run = 0;
+    weight = 1;
+    if (symbol == kEndOfBlock) {
+      break;
+    }
+
+    int rank = symbol - 1;
+    uint8_t byte = order[rank];
+    std::memmove(order.data() + 1, order.data(), rank);
+    order[0] = byte;
+    bwt.push_back(byte);
+  }
+  return bwt;
+}
+
+// huffman code lengths, frequencies are halved until the longest code fits
+std::array<uint8_t, kSymbolCount> BuildCodeLengths(
+    std::array<uint64_t, kSymbolCount> frequency) {
+  std::array<uint8_t, kSymbolCount> lengths{};
+  while (true) {
+    using Item = std::pair<uint64_t, int>;
+    std::priority_queue<Item, std::vector<Item>, std::greater<>> queue;
+    std::vector<int> parent(2 * kSymbolCount, -1);
+    int next_node = kSymbolCount;
+    for (int symbol = 0; symbol < kSymbolCount; ++symbol) {
+      if (frequency[symbol] > 0) {
+        queue.emplace(frequency[symbol], symbol);
+      }
+    }
+    if (queue.size() == 1) {
+      lengths.fill(0);
+      lengths[queue.top().second] = 1;
+      return lengths;
+    }
+    while (queue.size() > 1) {
+      auto [first_weight, first] = queue.top();
+      queue.pop();
+      auto [second_weight, second] = queue.top();
+      queue.pop();
+      parent[first] = parent[second] = next_node;
+      queue.emplace(first_weight + second_weight, next_node++);
+    }
+
+    int max_length = 0;
+    for (int symbol = 0; symbol < kSymbolCount; ++symbol) {
+      int length = 0;
+      for (int node = symbol; frequency[symbol] > 0 && parent[node] != -1;
+           node = parent[node]) {
+        ++length;
+      }
+      lengths[symbol] = length;
+      max_length = std::max(max_length, length);
+    }
+    if (max_length <= kMaxCodeLength) {
+      return lengths;
+    }
+    for (auto& value : frequency) {
+      value = (value == 0) ? 0 : value / 2 + 1;
+    }
+  }
+}
+
+// canonical codes: by length, then by symbol
+std::array<uint32_t, kSymbolCount> BuildCodes(
+    const std::array<uint8_t, kSymbolCount>& lengths) {
+  std::array<uint32_t, kSymbolCount> codes{};
+  uint32_t code = 0;
+  for (int length = 1; length <= kMaxCodeLength; ++length) {
+    for (int symbol = 0; symbol < kSymbolCount; ++symbol) {
+      if (lengths[symbol] == length) {
+        codes[symbol] = code++;
+      }
+    }
+    code <<= 1;
+  }
+  return codes;
+}
+
+class BitWriter {
+ public:
+  void Write(uint32_t value, int bit_count) {
+    for (int bit = bit_count - 1; bit >= 0; --bit) {
+      buffer_ = (buffer_ << 1) | ((value >> bit) & 1);
+      if (++buffered_ == 8) {
+        bytes_.push_back(static_cast<char>(buffer_));
+        buffer_ = 0;
+        buffered_ = 0;
+      }
+    }
+  }
+
+  std::string Finish() {
+    if (buffered_ > 0) {
+      bytes_.push_back(static_cast<char>(buffer_ << (8 - buffered_)));
+    }
+    return std::move(bytes_);
+  }
+
+ private:
+  std::string bytes_;
+  uint32_t buffer_ = 0;
+  int buffered_ = 0;
+};
+
+class BitReader {
+ public:
+  BitReader(const char* data, size_t size) : data_(data), size_(size) {}
+
+  // -1 once the data is exhausted
+  int ReadBit() {
+    if (position_ >= 8 * size_) {
+      return -1;
+    }
+    int bit =
+        (static_cast<uint8_t>(data_[position_ / 8]) >> (7 - position_ % 8)) & 1;
+    ++position_;
+    return bit;
+  }
+
+ private:
+  const char* data_;
+  size_t size_;
+  size_t position_ = 0;
+};
+
+void AppendUint32(std::string& out, uint32_t value) {
+  for (int shift = 0; shift < 32; shift += 8) {
+    out.push_back(static_cast<char>(value >> shift));
+  }
+}
+
+uint32_t ReadUint32(const char* data) {
+  uint32_t value = 0;
+  for (int shift = 0; shift < 32; shift += 8) {
+    value |= static_cast<uint32_t>(static_cast<uint8_t>(*data++)) << shift;
+  }
+  return value;
+}
+
+// crc-32 of zlib and bzip2 streams, reflected polynomial 0xEDB88320
+constexpr std::array<uint32_t, 256> BuildCRC32Table() {
+  std::array<uint32_t, 256> table{};
+  for (uint32_t byte = 0; byte < 256; ++byte) {
+    uint32_t value = byte;
+    for (int bit = 0; bit < 8; ++bit) {
+      value = (value & 1) ? (value >> 1) ^ 0xEDB88320 : value >> 1;
+    }
+    table[byte] = value;
+  }
+  return table;
+}
+
+constexpr std::array<uint32_t, 256> kCRC32Table = BuildCRC32Table();
+
+uint32_t ComputeCRC32(const std::string& data) {
+  uint32_t crc = UINT32_MAX;
+  for (char character : data) {
+    crc = kCRC32Table[(crc ^ static_cast<uint8_t>(character)) & 0xFF] ^
+          (crc >> 8);
+  }
+  return ~crc;
+}
+
+// block: [size][primary index][code lengths x 258][payload size][crc-32 of
+// the original block][payload]
+std::string CompressBlock(const std::string& block) {
+  uint32_t primary_index = 0;
+  std::vector<uint16_t> symbols =
+      EncodeMoveToFront(ComputeBWT(block, primary_index));
+
+  std::array<uint64_t, kSymbolCount> frequency{};
+  for (uint16_t symbol : symbols) {
+    ++frequency[symbol];
+  }
+  auto lengths = BuildCodeLengths(frequency);
+  auto codes = BuildCodes(lengths);
+
+  BitWriter writer;
+  for (uint16_t symbol : symbols) {
+    writer.Write(codes[symbol], lengths[symbol]);
+  }
+  std::string payload = writer.Finish();
+
+  std::string out;
+  AppendUint32(out, block.size());
+  AppendUint32(out, primary_index);
+  out.append(reinterpret_cast<const char*>(lengths.data()), kSymbolCount);
+  AppendUint32(out, payload.size());
+  AppendUint32(out, ComputeCRC32(block));
+  out += payload;
+  return out;
+}
+
+const size_t kBlockHeaderSize = 4 + 4 + kSymbolCount + 4 + 4;
+
+// std::nullopt if the header is inconsistent, the payload does not decode
+// to exactly the stored block size or the result fails the crc check
+std::optional<std::string> DecompressBlock(const char* data) {
+  uint32_t block_size = ReadUint32(data);
+  uint32_t primary_index = ReadUint32(data + 4);
+  std::array<uint8_t, kSymbolCount> lengths;
+  std::memcpy(lengths.data(), data + 8, kSymbolCount);
+  uint32_t payload_size = ReadUint32(data + 8 + kSymbolCount);
+  uint32_t crc = ReadUint32(data + 12 + kSymbolCount);
+
+  // the '$' row is never row 0, which holds the rotation starting with '$'
+  if (block_size == 0 || block_size > kBlockSize || primary_index == 0 ||
+      primary_index > block_size) {
+    return std::nullopt;
+  }
+
+  // Kraft inequality, sum of 2^-length over used symbols is at most 1
+  uint64_t kraft_sum = 0;
+  for (uint8_t length : lengths) {
+    if (length > kMaxCodeLength) {
+      return std::nullopt;
+    }
+    if (length > 0) {
+      kraft_sum += uint64_t{1} << (kMaxCodeLength - length);
+    }
+  }
+  if (kraft_sum > (uint64_t{1} << kMaxCodeLength) ||
+      lengths[kEndOfBlock] == 0) {
+    return std::nullopt;
+  }
+
+  // canonical decoding: codes of one length are consecutive
+  std::array<uint32_t, kMaxCodeLength + 2> first_code{};
+  std::array<uint32_t, kMaxCodeLength + 2> first_index{};
+  std::array<uint32_t, kMaxCodeLength + 2> count{};
+  std::vector<uint16_t> sorted_symbols;
+  uint32_t code = 0;
+  for (int length = 1; length <= kMaxCodeLength; ++length) {
+    first_code[length] = code;
+    first_index[length] = sorted_symbols.size();
+    for (int symbol = 0; symbol < kSymbolCount; ++symbol) {
+      if (lengths[symbol] == length) {
+        sorted_symbols.push_back(symbol);
+        ++count[length];
+        ++code;
+      }
+    }
+    code <<= 1;
+  }
+
+  BitReader reader(data + kBlockHeaderSize, payload_size);
+  std::vector<uint16_t> symbols;
+  while (symbols.empty() || symbols.back() != kEndOfBlock) {
+    uint32_t value = 0;
+    bool matched = false;
+    for (int length = 1; length <= kMaxCodeLength && !matched; ++length) {
+      int bit = reader.ReadBit();
+      if (bit < 0) {
+        return std::nullopt;
+      }
+      value = (value << 1) | bit;
+      if (value - first_code[length] < count[length]) {
+        symbols.push_back(
+            sorted_symbols[first_index[length] + value - first_code[length]]);
+        matched = true;
+      }
+    }
+    if (!matched) {
+      return std::nullopt;
+    }
+  }
+
+  auto bwt = DecodeMoveToFront(symbols, block_size);
+  if (!bwt || bwt->size() != block_size) {
+    return std::nullopt;
+  }
+  std::string block = InvertBWT(*bwt, primary_index);
+  if (ComputeCRC32(block) != crc) {
+    return std::nullopt;
+  }
+  return block;
+}
+
+// runs task(i) for i in [0, count) on all cores
+template <typename Task>
+void RunParallel(size_t count, Task&& task) {
+  size_t thread_count = std::min<size_t>(
+      count, std::max(1u, std::thread::hardware_concurrency()));
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < thread_count; ++t) {
+    threads.emplace_back([&, t] {
+      for (size_t i = t; i < count; i += thread_count) {
+        task(i);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+
+std::string Compress(const std::string& input) {
+  size_t block_count = (input.size() + kBlockSize - 1) / kBlockSize;
+  std::vector<std::string> blocks(block_count);
+  RunParallel(block_count, [&](size_t i) {
+    blocks[i] = CompressBlock(input.substr(i * kBlockSize, kBlockSize));
+  });
+
+  std::string out(kMagic, sizeof(kMagic));
+  for (const auto& block : blocks) {
+    out += block;
+  }
+  return out;
+}
+
+// std::nullopt on a malformed stream
+std::optional<std::string> Decompress(const std::string& input) {
+  bool ok = input.size() >= sizeof(kMagic) &&
+            std::memcmp(input.data(), kMagic, sizeof(kMagic)) == 0;
+  std::vector<size_t> offsets;
+  for (size_t offset = sizeof(kMagic); ok && offset < input.size();) {
+    if (offset + kBlockHeaderSize > input.size()) {
+      ok = false;
+      break;
+    }
+    offsets.push_back(offset);
+    offset += kBlockHeaderSize +
+              ReadUint32(input.data() + offset + 8 + kSymbolCount);
+    ok = offset <= input.size();
+  }
+  if (!ok) {
+    return std::nullopt;
+  }
+
+  std::vector<std::optional<std::string>> blocks(offsets.size());
+  RunParallel(offsets.size(), [&](size_t i) {
+    blocks[i] = DecompressBlock(input.data() + offsets[i]);
+  });
+
+  std::string out;
+  for (const auto& block : blocks) {
+    if (!block) {
+      return std::nullopt;
+    }
+    out += *block;
+  }
+  return out;
+}
+
+// bwt_compressor [-d] < input > output
+int main(int argc, char** argv) {
+  std::ios::sync_with_stdio(false);
+
+  std::string input{std::istreambuf_iterator<char>(std::cin),
+                    std::istreambuf_iterator<char>()};
+
+  if (argc > 1 && std::string(argv[1]) == "-d") {
+    auto output = Decompress(input);
+    if (!output) {
+      std::cerr << "malformed input\n";
+      return 1;
+    }
+    std::cout << *output;
+  } else {
+    std::cout << Compress(input);
+  }
+
+  return 0;
+}
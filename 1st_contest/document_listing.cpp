@@ -0,0 +1,340 @@
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+struct StringInfo {
+  uint64_t index;
+  uint64_t begin;
+  uint64_t end;
+};
+
+struct Suffix {
+  int index;  // begin of the suffix in the string
+  int rank;   //
+  int next_rank;
+
+  bool operator<(const Suffix& other) const {
+    return (this->rank == other.rank)
+               ? (this->next_rank < other.next_rank ? 1 : 0)
+               : (this->rank < other.rank ? 1 : 0);
+  }
+};
+
+// indexation from 0
+std::vector<int> BuildSuffixArray(const std::string& str) {
+  size_t n = str.size();
+  if (n == 0) {
+    return {};
+  }
+  std::vector<Suffix> suffix_data(n);
+
+  // assigning ranks & next_ranks to suffixes
+  for (int i = 0; i < n; i++) {
+    suffix_data[i].index = i;
+    suffix_data[i].rank = static_cast<unsigned char>(str[i]);
+    suffix_data[i].next_rank =
+        ((i + 1) < n) ? static_cast<unsigned char>(str[i + 1]) : -1;
+  }
+
+  // sorting the suffixes according to first 2 characters
+  std::sort(suffix_data.begin(), suffix_data.end());
+
+  // sorting suffixes according to first 4, 8, ... characters
+  std::vector<int> suffixes_index(
+      n);  // index in suffix_data by index in string
+  for (int i = 4; i < 2 * n; i = i * 2) {
+    int rank = 0;
+    int prev_rank = suffix_data[0].rank;
+    suffix_data[0].rank = rank;
+    suffixes_index[suffix_data[0].index] = 0;
+
+    for (int j = 1; j < n; j++) {
+      if (suffix_data[j].rank == prev_rank &&
+          suffix_data[j].next_rank == suffix_data[j - 1].next_rank) {
+        prev_rank = suffix_data[j].rank;
+        suffix_data[j].rank = rank;
+      } else {
+        prev_rank = suffix_data[j].rank;
+        suffix_data[j].rank = ++rank;
+      }
+      suffixes_index[suffix_data[j].index] = j;
+    }
+
+    // Assign next rank to every Suffix
+    for (int j = 0; j < n; j++) {
+      int next_index = suffix_data[j].index + i / 2;
+      suffix_data[j].next_rank =
+          (next_index < n) ? suffix_data[suffixes_index[next_index]].rank : -1;
+    }
+
+    // sorting the suffixes according to first i characters
+    std::sort(suffix_data.begin(), suffix_data.end());
+  }
+
+  std::vector<int> suffix_array(n);
+  for (int i = 0; i < n; i++) {
+    suffix_array[i] = suffix_data[i].index;
+  }
+
+  return suffix_array;
+}
+
+// indexation from 0, lcp[i] = LCP(suffix_array[i], suffix_array[i + 1]),
+// Kasai as in O.cpp
+std::vector<int> GetLCP(const std::string& str,
+                        const std::vector<int>& suffix_array) {
+  size_t n = str.size();
+  std::vector<int> lcp(n);
+
+  // inverse suffix array[j] = i <=> suffix_array[i] = j
+  std::vector<int> inverse_suffix_array(n);
+  for (int i = 0; i < n; ++i) {
+    inverse_suffix_array[suffix_array[i]] = i;
+  }
+
+  int current_lcp_value = 0;
+
+  for (int i = 0; i < n; ++i) {
+    if (inverse_suffix_array[i] == n - 1) {
+      continue;
+    }
+
+    int next = suffix_array[inverse_suffix_array[i] + 1];
+
+    while (std::max(i, next) + current_lcp_value < n &&
+           str[i + current_lcp_value] == str[next + current_lcp_value]) {
+      ++current_lcp_value;
+    }
+
+    lcp[inverse_suffix_array[i]] = current_lcp_value;
+    current_lcp_value = std::max(0, current_lcp_value - 1);
+  }
+
+  return lcp;
+}
+
+// argmin over [l, r) in O(1) after O(n log n) preprocessing
+class SparseTableArgMin {
+ public:
+  void Build(std::vector<int> values) {
+    values_ = std::move(values);
+    size_t n = values_.size();
+    log_.assign(n + 1, 0);
+    for (size_t i = 2; i <= n; ++i) {
+      log_[i] = log_[i / 2] + 1;
+    }
+
+    table_.emplace_back(n);
+    for (size_t i = 0; i < n; ++i) {
+      table_[0][i] = i;
+    }
+    for (size_t level = 1; (1u << level) <= n; ++level) {
+      size_t half = 1u << (level - 1);
+      table_.emplace_back(n - 2 * half + 1);
+      for (size_t i = 0; i + 2 * half <= n; ++i) {
+        table_[level][i] =
+            Better(table_[level - 1][i], table_[level - 1][i + half]);
+      }
+    }
+  }
+
+  int Query(size_t l, size_t r) const {
+    int level = log_[r - l];
+    return Better(table_[level][l], table_[level][r - (1u << level)]);
+  }
+
+  int Value(size_t i) const { return values_[i]; }
+
+ private:
+  std::vector<int> values_;
+  std::vector<int> log_;
+  std::vector<std::vector<int>> table_;
+
+  int Better(int lhs, int rhs) const {
+    return values_[lhs] <= values_[rhs] ? lhs : rhs;
+  }
+};
+
+// documents are joined with a separator below every pattern character, so
+// no occurrence crosses a boundary; previous[r] is the last rank before r
+// from the same document, and a document appears in a rank range [l, r)
+// iff exactly one of its ranks there has previous < l (Muthukrishnan)
+class DocumentCollection {
+ public:
+  static const char kSeparator = '\x01';
+
+  explicit DocumentCollection(const std::vector<std::string>& documents)
+      : string_data_(documents.size()) {
+    for (uint64_t i = 0; i < documents.size(); ++i) {
+      string_data_[i].begin = merged_string_.size();
+      merged_string_ += documents[i];
+      string_data_[i].end = merged_string_.size();
+      string_data_[i].index = i;
+      merged_string_ += kSeparator;
+    }
+
+    suffix_array_ = BuildSuffixArray(merged_string_);
+
+    std::vector<int> document_id(merged_string_.size());
+    for (const auto& info : string_data_) {
+      std::fill(document_id.begin() + info.begin,
+                document_id.begin() + info.end + 1, info.index);
+    }
+
+    std::vector<int> last_rank(documents.size(), -1);
+    std::vector<int> previous(suffix_array_.size());
+    rank_document_.resize(suffix_array_.size());
+    for (size_t rank = 0; rank < suffix_array_.size(); ++rank) {
+      int document = document_id[suffix_array_[rank]];
+      rank_document_[rank] = document;
+      previous[rank] = last_rank[document];
+      last_rank[document] = rank;
+    }
+
+    previous_arg_min_.Build(std::move(previous));
+    lcp_arg_min_.Build(GetLCP(merged_string_, suffix_array_));
+  }
+
+  // distinct documents containing the pattern, O(m + log n + documents)
+  std::vector<int> ListDocuments(const std::string& pattern) const {
+    auto [l, r] = FindRange(pattern);
+    std::vector<int> result;
+    std::vector<std::pair<int, int>> ranges;
+    if (l < r) {
+      ranges.emplace_back(l, r);
+    }
+
+    while (!ranges.empty()) {
+      auto [from, to] = ranges.back();
+      ranges.pop_back();
+      int rank = previous_arg_min_.Query(from, to);
+      if (previous_arg_min_.Value(rank) >= l) {
+        continue;
+      }
+      result.push_back(rank_document_[rank]);
+      if (from < rank) {
+        ranges.emplace_back(from, rank);
+      }
+      if (rank + 1 < to) {
+        ranges.emplace_back(rank + 1, to);
+      }
+    }
+
+    return result;
+  }
+
+ private:
+  std::vector<StringInfo> string_data_;
+  std::string merged_string_;
+  std::vector<int> suffix_array_;
+  std::vector<int> rank_document_;
+  // previous[r] of the Muthukrishnan scheme
+  SparseTableArgMin previous_arg_min_;
+  // Kasai's lcp of adjacent ranks, LCP of any two ranks is a range minimum
+  SparseTableArgMin lcp_arg_min_;
+
+  // LCP of the suffixes at ranks lhs < rhs
+  int GetRankLCP(int lhs, int rhs) const {
+    return lcp_arg_min_.Value(lcp_arg_min_.Query(lhs, rhs));
+  }
+
+  // first rank whose suffix is above the pattern, counting suffixes that
+  // start with it as above or below; binary search that keeps the pattern
+  // LCP of both bounds and skips the characters the LCP of the ranks
+  // already decides (Manber-Myers), O(m + log n)
+  int FindBoundary(const std::string& pattern, bool matches_below) const {
+    int m = pattern.size();
+    int lower = -1;
+    int upper = suffix_array_.size();
+    int lower_lcp = 0;
+    int upper_lcp = 0;
+
+    while (upper - lower > 1) {
+      int middle = lower + (upper - lower) / 2;
+      if (lower_lcp >= upper_lcp && lower >= 0) {
+        int lcp = std::min(GetRankLCP(lower, middle), m);
+        if (lcp > lower_lcp) {
+          lower = middle;
+          continue;
+        }
+        if (lcp < lower_lcp) {
+          upper = middle;
+          upper_lcp = lcp;
+          continue;
+        }
+      } else if (upper_lcp > lower_lcp) {
+        int lcp = std::min(GetRankLCP(middle, upper), m);
+        if (lcp > upper_lcp) {
+          upper = middle;
+          continue;
+        }
+        if (lcp < upper_lcp) {
+          lower = middle;
+          lower_lcp = lcp;
+          continue;
+        }
+      }
+
+      // the middle suffix agrees with the pattern on the first
+      // max(lower_lcp, upper_lcp) characters
+      size_t position = suffix_array_[middle];
+      int lcp = std::max(lower_lcp, upper_lcp);
+      while (lcp < m && position + lcp < merged_string_.size() &&
+             merged_string_[position + lcp] == pattern[lcp]) {
+        ++lcp;
+      }
+      bool below = (lcp == m)
+                       ? matches_below
+                       : position + lcp == merged_string_.size() ||
+                             static_cast<unsigned char>(
+                                 merged_string_[position + lcp]) <
+                                 static_cast<unsigned char>(pattern[lcp]);
+      if (below) {
+        lower = middle;
+        lower_lcp = lcp;
+      } else {
+        upper = middle;
+        upper_lcp = lcp;
+      }
+    }
+    return upper;
+  }
+
+  // ranks of suffixes starting with the pattern
+  std::pair<int, int> FindRange(const std::string& pattern) const {
+    return {FindBoundary(pattern, false), FindBoundary(pattern, true)};
+  }
+};
+
+int main() {
+  std::ios::sync_with_stdio(false);
+  std::cin.tie(nullptr);
+
+  size_t n = 0;
+  std::cin >> n;
+  std::vector<std::string> documents(n);
+  for (auto& document : documents) {
+    std::cin >> document;
+  }
+
+  DocumentCollection collection(documents);
+
+  size_t q = 0;
+  std::cin >> q;
+  for (size_t i = 0; i < q; ++i) {
+    std::string pattern;
+    std::cin >> pattern;
+
+    auto result = collection.ListDocuments(pattern);
+    std::cout << result.size();
+    for (int document : result) {
+      std::cout << ' ' << document + 1;
+    }
+    std::cout << '\n';
+  }
+
+  return 0;
+}
@@ -0,0 +1,295 @@
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <iostream>
+#include <numbers>
+#include <string>
+#include <vector>
+
+using Complex = std::complex<double>;
+
+static const double kPi = std::numbers::pi_v<double>;
+
+static const char kWildcard = '?';
+
+void BitReversePermute(std::vector<Complex>& poly) {
+  size_t length = poly.size();
+  for (size_t i = 1, j = 0; i < length; ++i) {
+    size_t half = length >> 1;
+    for (; j & half; half >>= 1) {
+      j ^= half;
+    }
+    j |= half;
+    if (i < j) {
+      std::swap(poly[i], poly[j]);
+    }
+  }
+}
+
+// roots[k] = e^(2 pi i k / length) for k < length / 2, each one computed
+// directly: w *= w_root drifts for sizes around 2^21 and the products here
+// reach 10^11
+std::vector<Complex> ComputeRoots(size_t length) {
+  std::vector<Complex> roots(length / 2);
+  for (size_t k = 0; k < roots.size(); ++k) {
+    roots[k] = std::polar(1.0, 2 * kPi * k / length);
+  }
+  return roots;
+}
+
+// same as 2nd_contest/H.cpp, but with the roots of ComputeRoots(poly.size()),
+// conjugated for the inverse transform
+void PerformFFT(std::vector<Complex>& poly, const std::vector<Complex>& roots,
+                bool invert = false) {
+  size_t length = poly.size();
+  BitReversePermute(poly);
+
+  for (size_t block_size = 2; block_size <= length; block_size <<= 1) {
+    size_t stride = length / block_size;
+    for (size_t start = 0; start < length; start += block_size) {
+      for (size_t offset = 0; offset < block_size / 2; ++offset) {
+        Complex even_val = poly[start + offset];
+        Complex root = roots[offset * stride];
+        if (invert) {
+          root = std::conj(root);
+        }
+        Complex odd_val = poly[start + offset + block_size / 2] * root;
+        poly[start + offset] = even_val + odd_val;
+        poly[start + offset + block_size / 2] = even_val - odd_val;
+      }
+    }
+  }
+
+  if (invert) {
+    for (auto& value : poly) {
+      value /= static_cast<double>(length);
+    }
+  }
+}
+
+size_t ComputeFFTSize(size_t targetSize) {
+  size_t fft_size = 1;
+  while (fft_size < targetSize) {
+    fft_size <<= 1;
+  }
+  return fft_size;
+}
+
+// correlation[i] = sum_j pattern[j] * text[i + j] for every alignment
+// i = 0..|text| - |pattern| is accumulated into the spectrum sum, so any
+// number of correlations costs a single inverse transform; the roots are
+// computed once per sum
+class CorrelationSum {
+ public:
+  CorrelationSum(size_t text_size, size_t pattern_size)
+      : text_size_(text_size),
+        pattern_size_(pattern_size),
+        sum_(ComputeFFTSize(text_size + pattern_size - 1)),
+        roots_(ComputeRoots(sum_.size())) {}
+
+  void Add(const std::vector<double>& text, const std::vector<double>& pattern,
+           double weight) {
+    std::vector<Complex> text_values(sum_.size());
+    std::vector<Complex> pattern_values(sum_.size());
+    for (size_t i = 0; i < text_size_; ++i) {
+      text_values[i] = text[i];
+    }
+    // reversed, so the correlation at i lands at index i + |pattern| - 1
+    for (size_t j = 0; j < pattern_size_; ++j) {
+      pattern_values[pattern_size_ - 1 - j] = pattern[j];
+    }
+
+    PerformFFT(text_values, roots_, false);
+    PerformFFT(pattern_values, roots_, false);
+    for (size_t i = 0; i < sum_.size(); ++i) {
+      sum_[i] += weight * text_values[i] * pattern_values[i];
+    }
+  }
+
+  std::vector<int64_t> GetResult() {
+    PerformFFT(sum_, roots_, true);
+    std::vector<int64_t> result(text_size_ - pattern_size_ + 1);
+    for (size_t i = 0; i < result.size(); ++i) {
+      result[i] = std::llround(sum_[i + pattern_size_ - 1].real());
+    }
+    return result;
+  }
+
+ private:
+  size_t text_size_;
+  size_t pattern_size_;
+  std::vector<Complex> sum_;
+  std::vector<Complex> roots_;
+};
+
+// mismatches[i] - number of non-wildcard mask positions j with
+// mask[j] != text[i + j] and text[i + j] != '?'; one correlation of indicator
+// vectors per distinct byte of the mask, O(sigma * n log n)
+std::vector<int64_t> CountMismatches(const std::string& mask,
+                                     const std::string& text) {
+  if (mask.empty() || mask.size() > text.size()) {
+    return {};
+  }
+
+  std::vector<bool> in_mask(256, false);
+  int64_t fixed_count = 0;
+  for (char character : mask) {
+    if (character != kWildcard) {
+      in_mask[static_cast<uint8_t>(character)] = true;
+      ++fixed_count;
+    }
+  }
+
+  CorrelationSum matches(text.size(), mask.size());
+  for (size_t byte = 0; byte < 256; ++byte) {
+    if (!in_mask[byte]) {
+      continue;
+    }
+    std::vector<double> text_indicator(text.size());
+    std::vector<double> mask_indicator(mask.size());
+    for (size_t i = 0; i < text.size(); ++i) {
+      text_indicator[i] = (static_cast<uint8_t>(text[i]) == byte) ? 1 : 0;
+    }
+    for (size_t j = 0; j < mask.size(); ++j) {
+      mask_indicator[j] = (static_cast<uint8_t>(mask[j]) == byte) ? 1 : 0;
+    }
+    matches.Add(text_indicator, mask_indicator, 1);
+  }
+  // a '?' in the text matches any mask byte, as in FindWildcardOccurrences
+  if (text.find(kWildcard) != std::string::npos) {
+    std::vector<double> text_wildcards(text.size());
+    std::vector<double> mask_fixed(mask.size());
+    for (size_t i = 0; i < text.size(); ++i) {
+      text_wildcards[i] = (text[i] == kWildcard) ? 1 : 0;
+    }
+    for (size_t j = 0; j < mask.size(); ++j) {
+      mask_fixed[j] = (mask[j] != kWildcard) ? 1 : 0;
+    }
+    matches.Add(text_wildcards, mask_fixed, 1);
+  }
+
+  std::vector<int64_t> mismatches = matches.GetResult();
+  for (int64_t& value : mismatches) {
+    value = fixed_count - value;
+  }
+  return mismatches;
+}
+
+std::vector<size_t> FindApproximateOccurrences(const std::string& mask,
+                                               const std::string& text,
+                                               int64_t max_mismatches) {
+  std::vector<size_t> occurrences;
+  auto mismatches = CountMismatches(mask, text);
+  for (size_t i = 0; i < mismatches.size(); ++i) {
+    if (mismatches[i] <= max_mismatches) {
+      occurrences.push_back(i);
+    }
+  }
+  return occurrences;
+}
+
+// '?' -> 0, the distinct bytes of the mask -> 1..sigma in byte order, every
+// other byte -> sigma + 1: such a byte never matches a mask byte, and codes
+// stay small enough for the double FFT to round the sums exactly
+std::array<double, 256> GetSymbolCodes(const std::string& mask) {
+  std::array<bool, 256> in_mask{};
+  for (char character : mask) {
+    in_mask[static_cast<uint8_t>(character)] = true;
+  }
+  in_mask[static_cast<uint8_t>(kWildcard)] = false;
+
+  std::array<double, 256> codes{};
+  double next_code = 1;
+  for (size_t byte = 0; byte < 256; ++byte) {
+    if (in_mask[byte]) {
+      codes[byte] = next_code++;
+    }
+  }
+  for (size_t byte = 0; byte < 256; ++byte) {
+    if (!in_mask[byte]) {
+      codes[byte] = next_code;
+    }
+  }
+  codes[static_cast<uint8_t>(kWildcard)] = 0;
+  return codes;
+}
+
+std::vector<double> GetPowers(const std::string& str,
+                              const std::array<double, 256>& codes,
+                              int exponent) {
+  std::vector<double> powers(str.size());
+  for (size_t i = 0; i < str.size(); ++i) {
+    powers[i] = std::pow(codes[static_cast<uint8_t>(str[i])], exponent);
+  }
+  return powers;
+}
+
+// bound on max_code^4 * |mask| * log2(transform size): the largest sum is
+// max_code^4 * |mask| and the FFT error grows with log2 of the transform
+// size; measured error stays below 2e-17 times this value (1.3e-3 at
+// 9.3e13, |text| = 4 * 10^6 with 256 codes, and 1.1e-4 for
+// |text| = 4 * 10^6, |mask| = 10^6 with 27 codes), far from the 0.5 that
+// breaks rounding
+static const double kMaxExactSum = 1e14;
+
+// sum_j p_j t_{i+j} (p_j - t_{i+j})^2 is zero iff every pair matches or has
+// a wildcard ('?' may appear on both sides); expands into three
+// correlations, O(n log n) whatever the fragments of the mask look like;
+// masks with too many distinct bytes for exact rounding fall back to the
+// mismatch counts
+std::vector<size_t> FindWildcardOccurrences(const std::string& mask,
+                                            const std::string& text) {
+  if (mask.empty() || mask.size() > text.size()) {
+    return {};
+  }
+
+  auto codes = GetSymbolCodes(mask);
+  double max_code = *std::max_element(codes.begin(), codes.end());
+  double fft_size = ComputeFFTSize(text.size() + mask.size() - 1);
+  if (std::pow(max_code, 4) * mask.size() * std::log2(fft_size) >
+      kMaxExactSum) {
+    return FindApproximateOccurrences(mask, text, 0);
+  }
+
+  CorrelationSum sum(text.size(), mask.size());
+  sum.Add(GetPowers(text, codes, 1), GetPowers(mask, codes, 3), 1);
+  sum.Add(GetPowers(text, codes, 2), GetPowers(mask, codes, 2), -2);
+  sum.Add(GetPowers(text, codes, 3), GetPowers(mask, codes, 1), 1);
+
+  std::vector<size_t> occurrences;
+  auto distances = sum.GetResult();
+  for (size_t i = 0; i < distances.size(); ++i) {
+    if (distances[i] == 0) {
+      occurrences.push_back(i);
+    }
+  }
+  return occurrences;
+}
+
+// input: mask, text and the number of allowed mismatches k; prints the
+// starting positions as K.cpp does
+int main() {
+  std::ios::sync_with_stdio(false);
+  std::cin.tie(nullptr);
+
+  std::string mask;
+  std::string text;
+  int64_t max_mismatches = 0;
+  std::cin >> mask >> text >> max_mismatches;
+
+  auto occurrences =
+      (max_mismatches == 0)
+          ? FindWildcardOccurrences(mask, text)
+          : FindApproximateOccurrences(mask, text, max_mismatches);
+
+  std::string output;
+  for (size_t position : occurrences) {
+    output += std::to_string(position);
+    output += ' ';
+  }
+  std::cout << output << '\n';
+
+  return 0;
+}
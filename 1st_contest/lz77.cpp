@@ -0,0 +1,228 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+
+struct Suffix {
+  int index;  // begin of the suffix in the string
+  int rank;   //
+  int next_rank;
+
+  bool operator<(const Suffix& other) const {
+    return (this->rank == other.rank)
+               ? (this->next_rank < other.next_rank ? 1 : 0)
+               : (this->rank < other.rank ? 1 : 0);
+  }
+};
+
+// indexation from 0
+std::vector<int> BuildSuffixArray(const std::string& str) {
+  size_t n = str.size();
+  if (n == 0) {
+    return {};
+  }
+  std::vector<Suffix> suffix_data(n);
+
+  // assigning ranks & next_ranks to suffixes
+  for (int i = 0; i < n; i++) {
+    suffix_data[i].index = i;
+    suffix_data[i].rank = static_cast<unsigned char>(str[i]);
+    suffix_data[i].next_rank =
+        ((i + 1) < n) ? static_cast<unsigned char>(str[i + 1]) : -1;
+  }
+
+  // sorting the suffixes according to first 2 characters
+  std::sort(suffix_data.begin(), suffix_data.end());
+
+  // sorting suffixes according to first 4, 8, ... characters
+  std::vector<int> suffixes_index(
+      n);  // index in suffix_data by index in string
+  for (int i = 4; i < 2 * n; i = i * 2) {
+    int rank = 0;
+    int prev_rank = suffix_data[0].rank;
+    suffix_data[0].rank = rank;
+    suffixes_index[suffix_data[0].index] = 0;
+
+    for (int j = 1; j < n; j++) {
+      if (suffix_data[j].rank == prev_rank &&
+          suffix_data[j].next_rank == suffix_data[j - 1].next_rank) {
+        prev_rank = suffix_data[j].rank;
+        suffix_data[j].rank = rank;
+      } else {
+        prev_rank = suffix_data[j].rank;
+        suffix_data[j].rank = ++rank;
+      }
+      suffixes_index[suffix_data[j].index] = j;
+    }
+
+    // Assign next rank to every Suffix
+    for (int j = 0; j < n; j++) {
+      int next_index = suffix_data[j].index + i / 2;
+      suffix_data[j].next_rank =
+          (next_index < n) ? suffix_data[suffixes_index[next_index]].rank : -1;
+    }
+
+    // sorting the suffixes according to first i characters
+    std::sort(suffix_data.begin(), suffix_data.end());
+  }
+
+  std::vector<int> suffix_array(n);
+  for (int i = 0; i < n; i++) {
+    suffix_array[i] = suffix_data[i].index;
+  }
+
+  return suffix_array;
+}
+
+// phrase of the factorization: a copy of text[source..source + length) or,
+// when length == 0, the literal byte source
+struct Phrase {
+  int source;
+  int length;
+};
+
+int GetCommonPrefix(const std::string& str, int i, int j) {
+  int n = str.size();
+  int length = 0;
+  while (std::max(i, j) + length < n && str[i + length] == str[j + length]) {
+    ++length;
+  }
+  return length;
+}
+
+// KKP3: the longest previous factor at i is shared with one of the nearest
+// suffixes in SA order that start before i (previous / next smaller value of
+// the suffix array), naive LCE is bounded by the phrase length, so the scan
+// is O(n) after the suffix array; on_phrase(position, phrase) is streamed
+template <typename OnPhrase>
+void FactorizeLZ77(const std::string& str, OnPhrase&& on_phrase) {
+  int n = str.size();
+  std::vector<int> suffix_array = BuildSuffixArray(str);
+
+  // psv[i] / nsv[i] - text position or -1, indexed by text position
+  std::vector<int> psv(n, -1);
+  std::vector<int> nsv(n, -1);
+  std::vector<int> stack;
+  for (int rank = 0; rank < n; ++rank) {
+    int position = suffix_array[rank];
+    while (!stack.empty() && stack.back() > position) {
+      nsv[stack.back()] = position;
+      stack.pop_back();
+    }
+    psv[position] = stack.empty() ? -1 : stack.back();
+    stack.push_back(position);
+  }
+
+  for (int i = 0; i < n;) {
+    int best_source = -1;
+    int best_length = 0;
+    for (int candidate : {psv[i], nsv[i]}) {
+      if (candidate == -1) {
+        continue;
+      }
+      int length = GetCommonPrefix(str, i, candidate);
+      if (length > best_length) {
+        best_length = length;
+        best_source = candidate;
+      }
+    }
+
+    if (best_length == 0) {
+      on_phrase(i, Phrase{static_cast<unsigned char>(str[i]), 0});
+      ++i;
+    } else {
+      on_phrase(i, Phrase{best_source, best_length});
+      i += best_length;
+    }
+  }
+}
+
+// reference: longest match among the last window_size positions by brute force
+template <typename OnPhrase>
+void FactorizeLZ77Naive(const std::string& str, int window_size,
+                        OnPhrase&& on_phrase) {
+  int n = str.size();
+  for (int i = 0; i < n;) {
+    int best_source = -1;
+    int best_length = 0;
+    for (int candidate = std::max(0, i - window_size); candidate < i;
+         ++candidate) {
+      int length = GetCommonPrefix(str, i, candidate);
+      if (length > best_length) {
+        best_length = length;
+        best_source = candidate;
+      }
+    }
+
+    if (best_length == 0) {
+      on_phrase(i, Phrase{static_cast<unsigned char>(str[i]), 0});
+      ++i;
+    } else {
+      on_phrase(i, Phrase{best_source, best_length});
+      i += best_length;
+    }
+  }
+}
+
+// throughput in MB/s on a random and on a repetitive text
+void Benchmark(int length, int window_size) {
+  std::mt19937 generator(42);
+  std::string random_text(length, 'a');
+  for (char& character : random_text) {
+    character = 'a' + generator() % 4;
+  }
+  std::string repetitive_text(length, 'a');
+  for (int i = 0; i < length; ++i) {
+    repetitive_text[i] = (i % 997 == 0) ? 'a' + generator() % 4
+                                        : repetitive_text[i % 5000];
+  }
+
+  for (const std::string* text : {&random_text, &repetitive_text}) {
+    size_t phrases = 0;
+    auto count_phrase = [&](int, Phrase) { ++phrases; };
+
+    auto start = std::chrono::steady_clock::now();
+    FactorizeLZ77(*text, count_phrase);
+    std::chrono::duration<double> fast = std::chrono::steady_clock::now() - start;
+    size_t fast_phrases = phrases;
+
+    phrases = 0;
+    start = std::chrono::steady_clock::now();
+    FactorizeLZ77Naive(*text, window_size, count_phrase);
+    std::chrono::duration<double> naive =
+        std::chrono::steady_clock::now() - start;
+
+    std::cout << "KKP3: " << length / fast.count() / 1e6 << " MB/s, "
+              << fast_phrases << " phrases; naive (window " << window_size
+              << "): " << length / naive.count() / 1e6 << " MB/s, " << phrases
+              << " phrases\n";
+  }
+}
+
+int main() {
+  std::ios::sync_with_stdio(false);
+  std::cin.tie(nullptr);
+
+  std::string text{std::istreambuf_iterator<char>(std::cin),
+                   std::istreambuf_iterator<char>()};
+
+  std::string output;
+  size_t phrases = 0;
+  FactorizeLZ77(text, [&](int, Phrase phrase) {
+    ++phrases;
+    output += std::to_string(phrase.source);
+    output += ' ';
+    output += std::to_string(phrase.length);
+    output += '\n';
+  });
+
+  std::cout << phrases << '\n' << output;
+
+  // Benchmark(10'000'000, 4096);
+
+  return 0;
+}
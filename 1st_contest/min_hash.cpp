@@ -0,0 +1,211 @@
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+const uint64_t KHashPrimary1 = 313;
+const uint64_t KHashPrimary2 = 317;
+
+struct HashPair {
+  uint64_t hash1, hash2;
+  bool operator==(const HashPair& other) const {
+    return hash1 == other.hash1 && hash2 == other.hash2;
+  }
+};
+
+std::vector<HashPair> ComputePrefixHashes(const std::string& str, uint64_t n) {
+  std::vector<HashPair> hash(n + 1, {0, 0});
+  for (uint64_t i = 0; i < n; ++i) {
+    hash[i + 1].hash1 = (hash[i].hash1 * KHashPrimary1 + uint64_t(str[i]));
+    hash[i + 1].hash2 = (hash[i].hash2 * KHashPrimary2 + uint64_t(str[i]));
+  }
+  return hash;
+}
+
+std::vector<HashPair> ComputePowers(uint64_t n) {
+  std::vector<HashPair> power(n + 1, {1, 1});
+  for (uint64_t i = 1; i <= n; ++i) {
+    power[i].hash1 = (power[i - 1].hash1 * KHashPrimary1);
+    power[i].hash2 = (power[i - 1].hash2 * KHashPrimary2);
+  }
+  return power;
+}
+
+HashPair GetSubstrHash(const std::vector<HashPair>& hash,
+                       const std::vector<HashPair>& power, uint64_t l,
+                       uint64_t r) {
+  return {(hash[r].hash1 - (hash[l].hash1 * power[r - l].hash1)),
+          (hash[r].hash2 - (hash[l].hash2 * power[r - l].hash2))};
+}
+
+// sketch parameters: kSketchSize = kBandCount * kRowsPerBand,
+// candidate threshold of the banding is about (1 / b) ^ (1 / r) ~ 0.42
+const size_t kShingleLength = 5;
+const size_t kSketchSize = 128;
+const size_t kBandCount = 32;
+const size_t kRowsPerBand = kSketchSize / kBandCount;
+
+using Sketch = std::array<uint64_t, kSketchSize>;
+
+// splitmix64 finalizer
+uint64_t MixHash(uint64_t value) {
+  value += 0x9e3779b97f4a7c15ULL;
+  value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  value = (value ^ (value >> 27)) * 0x94d049bb133111ebULL;
+  return value ^ (value >> 31);
+}
+
+// hashes of all kShingleLength-grams of the document, rolling hash over
+// the prefix hashes; a document shorter than a shingle is one shingle
+std::vector<uint64_t> GetShingleHashes(const std::string& document) {
+  uint64_t n = document.size();
+  uint64_t length = std::min<uint64_t>(kShingleLength, n);
+  std::vector<uint64_t> shingles;
+  if (n == 0) {
+    return shingles;
+  }
+
+  std::vector<HashPair> prefix_hashes = ComputePrefixHashes(document, n);
+  std::vector<HashPair> powers = ComputePowers(length);
+
+  shingles.reserve(n - length + 1);
+  for (uint64_t i = 0; i + length <= n; ++i) {
+    HashPair hash = GetSubstrHash(prefix_hashes, powers, i, i + length);
+    shingles.push_back(hash.hash1 ^ MixHash(hash.hash2));
+  }
+
+  // duplicates do not change the minimums, drop them to save mixing work
+  std::sort(shingles.begin(), shingles.end());
+  shingles.erase(std::unique(shingles.begin(), shingles.end()),
+                 shingles.end());
+  return shingles;
+}
+
+// i-th value is min over shingles of the i-th hash function
+Sketch BuildSketch(const std::string& document) {
+  Sketch sketch;
+  sketch.fill(UINT64_MAX);
+
+  for (uint64_t shingle : GetShingleHashes(document)) {
+    for (size_t i = 0; i < kSketchSize; ++i) {
+      sketch[i] = std::min(sketch[i], MixHash(shingle ^ MixHash(i)));
+    }
+  }
+
+  return sketch;
+}
+
+// P(min_i(A) == min_i(B)) = |A & B| / |A | B|
+double EstimateJaccard(const Sketch& lhs, const Sketch& rhs) {
+  size_t equal = 0;
+  for (size_t i = 0; i < kSketchSize; ++i) {
+    equal += (lhs[i] == rhs[i]) ? 1 : 0;
+  }
+  return static_cast<double>(equal) / kSketchSize;
+}
+
+class LshIndex {
+ public:
+  LshIndex() : buckets_(kBandCount) {}
+
+  uint32_t Add(const Sketch& sketch) {
+    uint32_t id = sketches_.size();
+    sketches_.push_back(sketch);
+    for (size_t band = 0; band < kBandCount; ++band) {
+      buckets_[band][GetBandHash(sketch, band)].push_back(id);
+    }
+    return id;
+  }
+
+  const Sketch& GetSketch(uint32_t id) const { return sketches_[id]; }
+
+  size_t Size() const { return sketches_.size(); }
+
+  // documents sharing at least one band with the sketch
+  std::vector<uint32_t> GetCandidates(const Sketch& sketch) const {
+    std::vector<uint32_t> candidates;
+    for (size_t band = 0; band < kBandCount; ++band) {
+      auto it = buckets_[band].find(GetBandHash(sketch, band));
+      if (it != buckets_[band].end()) {
+        candidates.insert(candidates.end(), it->second.begin(),
+                          it->second.end());
+      }
+    }
+    std::sort(candidates.begin(), candidates.end());
+    candidates.erase(std::unique(candidates.begin(), candidates.end()),
+                     candidates.end());
+    return candidates;
+  }
+
+  // pairs (i < j) sharing at least one band
+  std::vector<std::pair<uint32_t, uint32_t>> GetCandidatePairs() const {
+    std::vector<std::pair<uint32_t, uint32_t>> pairs;
+    for (const auto& band_buckets : buckets_) {
+      for (const auto& [_, ids] : band_buckets) {
+        for (size_t i = 0; i < ids.size(); ++i) {
+          for (size_t j = i + 1; j < ids.size(); ++j) {
+            pairs.emplace_back(ids[i], ids[j]);
+          }
+        }
+      }
+    }
+    std::sort(pairs.begin(), pairs.end());
+    pairs.erase(std::unique(pairs.begin(), pairs.end()), pairs.end());
+    return pairs;
+  }
+
+ private:
+  std::vector<std::unordered_map<uint64_t, std::vector<uint32_t>>> buckets_;
+  std::vector<Sketch> sketches_;
+
+  static uint64_t GetBandHash(const Sketch& sketch, size_t band) {
+    uint64_t hash = band;
+    for (size_t i = band * kRowsPerBand; i < (band + 1) * kRowsPerBand; ++i) {
+      hash = MixHash(hash ^ sketch[i]);
+    }
+    return hash;
+  }
+};
+
+std::vector<std::pair<uint32_t, uint32_t>> FindNearDuplicates(
+    const LshIndex& index, double threshold) {
+  std::vector<std::pair<uint32_t, uint32_t>> result;
+  for (auto [i, j] : index.GetCandidatePairs()) {
+    if (EstimateJaccard(index.GetSketch(i), index.GetSketch(j)) >= threshold) {
+      result.emplace_back(i, j);
+    }
+  }
+  return result;
+}
+
+int main() {
+  size_t n = 0;
+  double threshold = 0;
+  std::cin >> n >> threshold;
+
+  std::string document;
+  std::getline(std::cin, document);
+
+  LshIndex index;
+  for (size_t i = 0; i < n; ++i) {
+    std::getline(std::cin, document);
+    index.Add(BuildSketch(document));
+  }
+
+  auto result = FindNearDuplicates(index, threshold);
+
+  std::cout << result.size() << '\n';
+  std::cout << std::fixed << std::setprecision(3);
+  for (auto [i, j] : result) {
+    std::cout << i + 1 << ' ' << j + 1 << ' '
+              << EstimateJaccard(index.GetSketch(i), index.GetSketch(j))
+              << '\n';
+  }
+
+  return 0;
+}
@@ -0,0 +1,133 @@
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// eertree: node 0 is the imaginary root of length -1, node 1 is the empty
+// string; every other node is a distinct palindrome of the stream
+class PalindromicTree {
+ public:
+  static const size_t kAlphabetSize = 26;
+  static const char kFirstChar = 'a';
+
+  PalindromicTree() {
+    AddNode(-1, 0);
+    AddNode(0, 0);
+    min_factorization_.push_back(0);
+  }
+
+  void Reserve(size_t n) {
+    text_.reserve(n);
+    length_.reserve(n + 2);
+    link_.reserve(n + 2);
+    diff_.reserve(n + 2);
+    series_link_.reserve(n + 2);
+    series_answer_.reserve(n + 2);
+    next_.reserve(n + 2);
+    min_factorization_.reserve(n + 1);
+  }
+
+  // amortized O(1) for the tree, O(log n) for the factorization update
+  void Append(char character) {
+    int32_t position = text_.size();
+    size_t index = character - kFirstChar;
+    text_.push_back(character);
+
+    int32_t parent = FindExtendable(last_, position);
+    if (next_[parent][index] == 0) {
+      int32_t link = (length_[parent] == -1)
+                         ? 1
+                         : next_[FindExtendable(link_[parent], position)][index];
+      int32_t node = AddNode(length_[parent] + 2, link);
+      next_[parent][index] = node;
+    }
+    last_ = next_[parent][index];
+
+    UpdateMinFactorization();
+  }
+
+  size_t GetDistinctCount() const { return length_.size() - 2; }
+
+  // minimum number of palindromes the current prefix splits into
+  int32_t GetMinFactorization() const { return min_factorization_.back(); }
+
+ private:
+  std::string text_;
+  int32_t last_ = 1;
+
+  std::vector<int32_t> length_;
+  std::vector<int32_t> link_;
+  // diff = length - length[link], series_link skips links with equal diff
+  std::vector<int32_t> diff_;
+  std::vector<int32_t> series_link_;
+  std::vector<int32_t> series_answer_;
+  std::vector<std::array<int32_t, kAlphabetSize>> next_;
+
+  // min_factorization_[i] - answer for the prefix of length i
+  std::vector<int32_t> min_factorization_;
+
+  int32_t AddNode(int32_t length, int32_t link) {
+    int32_t node = length_.size();
+    length_.push_back(length);
+    link_.push_back(link);
+    diff_.push_back(node < 2 ? 0 : length - length_[link]);
+    series_link_.push_back(
+        (node < 2 || diff_[node] != diff_[link]) ? link : series_link_[link]);
+    series_answer_.push_back(0);
+    next_.emplace_back();
+    next_.back().fill(0);
+    return node;
+  }
+
+  int32_t FindExtendable(int32_t node, int32_t position) const {
+    while (true) {
+      int32_t mirror = position - length_[node] - 1;
+      // the imaginary root always matches: mirror == position
+      if (mirror >= 0 && text_[mirror] == text_[position]) {
+        return node;
+      }
+      node = link_[node];
+    }
+  }
+
+  // suffix palindromes split into O(log n) series of equal diff, each series
+  // reuses the answer stored at its top node
+  void UpdateMinFactorization() {
+    int32_t prefix_length = text_.size();
+    int32_t best = prefix_length;
+
+    for (int32_t node = last_; length_[node] > 0; node = series_link_[node]) {
+      series_answer_[node] =
+          min_factorization_[prefix_length -
+                             (length_[series_link_[node]] + diff_[node])];
+      if (diff_[node] == diff_[link_[node]]) {
+        series_answer_[node] =
+            std::min(series_answer_[node], series_answer_[link_[node]]);
+      }
+      best = std::min(best, series_answer_[node] + 1);
+    }
+
+    min_factorization_.push_back(best);
+  }
+};
+
+int main() {
+  std::ios::sync_with_stdio(false);
+  std::cin.tie(nullptr);
+
+  std::string text;
+  std::cin >> text;
+
+  PalindromicTree tree;
+  tree.Reserve(text.size());
+
+  for (char character : text) {
+    tree.Append(character);
+    std::cout << tree.GetDistinctCount() << ' ' << tree.GetMinFactorization()
+              << '\n';
+  }
+
+  return 0;
+}
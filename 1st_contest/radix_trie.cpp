@@ -0,0 +1,429 @@
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <optional>
+#include <random>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// path-compressed trie: the label of the edge into a node is
+// keys_[label_begin_[v]..label_begin_[v] + label_length_[v]); only the label
+// of a new leaf is copied into keys_, splits reuse it; children are a
+// sibling list sorted by the first byte of the label, 21 bytes per node and
+// at most 2 * (number of keys) nodes
+class RadixTrie {
+ public:
+  static constexpr uint32_t kRoot = 0;
+  static constexpr uint32_t kNone = UINT32_MAX;
+
+  RadixTrie() { AddNode(0, 0); }
+
+  // id of the key, an existing key keeps its id
+  uint32_t Insert(std::string_view key) {
+    uint32_t node = kRoot;
+    size_t pos = 0;
+
+    while (pos < key.size()) {
+      uint32_t previous = kNone;
+      uint32_t child = FindChild(node, key[pos], previous);
+
+      if (child == kNone || first_byte_[child] != key[pos]) {
+        uint32_t label_begin = keys_.size();
+        keys_.append(key.substr(pos));
+        uint32_t leaf = AddNode(label_begin, key.size() - pos);
+        LinkChild(node, previous, leaf);
+        node = leaf;
+        break;
+      }
+
+      std::string_view label = GetLabel(child);
+      size_t common = GetCommonPrefix(label, key.substr(pos));
+      if (common < label.size()) {
+        // split the edge: node -> middle -> child
+        uint32_t middle = AddNode(label_begin_[child], common);
+        label_begin_[child] += common;
+        label_length_[child] -= common;
+        first_byte_[child] = keys_[label_begin_[child]];
+        next_sibling_[middle] = next_sibling_[child];
+        next_sibling_[child] = kNone;
+        first_child_[middle] = child;
+        if (previous == kNone) {
+          first_child_[node] = middle;
+        } else {
+          next_sibling_[previous] = middle;
+        }
+        child = middle;
+      }
+      node = child;
+      pos += common;
+    }
+
+    if (key_id_[node] == kNone) {
+      key_id_[node] = key_count_++;
+    }
+    return key_id_[node];
+  }
+
+  std::optional<uint32_t> Find(std::string_view key) const {
+    Locus locus = Descend(key);
+    if (locus.node == kNone || locus.below != 0 ||
+        key_id_[locus.node] == kNone) {
+      return std::nullopt;
+    }
+    return key_id_[locus.node];
+  }
+
+  // length of the longest key that is a prefix of text
+  std::optional<size_t> FindLongestPrefix(std::string_view text) const {
+    std::optional<size_t> result;
+    if (key_id_[kRoot] != kNone) {
+      result = 0;
+    }
+
+    uint32_t node = kRoot;
+    size_t pos = 0;
+    while (pos < text.size()) {
+      uint32_t previous = kNone;
+      uint32_t child = FindChild(node, text[pos], previous);
+      if (child == kNone || first_byte_[child] != text[pos]) {
+        break;
+      }
+      std::string_view label = GetLabel(child);
+      if (text.substr(pos, label.size()) != label) {
+        break;
+      }
+      node = child;
+      pos += label.size();
+      if (key_id_[node] != kNone) {
+        result = pos;
+      }
+    }
+    return result;
+  }
+
+  // on_key(key, id) for every key starting with prefix, lexicographic order
+  template <typename OnKey>
+  void ForEachKeyWithPrefix(std::string_view prefix, OnKey&& on_key) const {
+    Locus locus = Descend(prefix);
+    if (locus.node == kNone) {
+      return;
+    }
+
+    // the prefix may end inside the edge into locus.node
+    std::string key(prefix);
+    std::string_view label = GetLabel(locus.node);
+    key.append(label.substr(label.size() - locus.below));
+
+    // (node, length of the key above its edge), preorder
+    std::vector<std::pair<uint32_t, size_t>> stack = {
+        {locus.node, key.size() - label.size()}};
+    while (!stack.empty()) {
+      auto [current, length] = stack.back();
+      stack.pop_back();
+      key.resize(length);
+      key.append(GetLabel(current));
+
+      if (key_id_[current] != kNone) {
+        on_key(static_cast<const std::string&>(key), key_id_[current]);
+      }
+
+      // reversed, so the smallest child is popped first
+      size_t stack_size = stack.size();
+      for (uint32_t child = first_child_[current]; child != kNone;
+           child = next_sibling_[child]) {
+        stack.emplace_back(child, key.size());
+      }
+      std::reverse(stack.begin() + stack_size, stack.end());
+    }
+  }
+
+  // every key in lexicographic order, e.g. to feed AhoKorasikTrie::AddString
+  template <typename OnKey>
+  void ForEachKey(OnKey&& on_key) const {
+    ForEachKeyWithPrefix("", on_key);
+  }
+
+  // for a dictionary that is done growing: renumbers nodes in BFS order, so
+  // siblings are adjacent and a sibling scan reads consecutive memory
+  void RenumberInBFSOrder() {
+    std::vector<uint32_t> order = {kRoot};
+    for (size_t head = 0; head < order.size(); ++head) {
+      for (uint32_t child = first_child_[order[head]]; child != kNone;
+           child = next_sibling_[child]) {
+        order.push_back(child);
+      }
+    }
+
+    std::vector<uint32_t> new_id(order.size());
+    for (uint32_t node = 0; node < order.size(); ++node) {
+      new_id[order[node]] = node;
+    }
+    auto renumber = [&](uint32_t node) {
+      return (node == kNone) ? kNone : new_id[node];
+    };
+
+    auto permute = [&](auto& values, auto map) {
+      std::remove_reference_t<decltype(values)> permuted(values.size());
+      for (uint32_t node = 0; node < order.size(); ++node) {
+        permuted[node] = map(values[order[node]]);
+      }
+      values = std::move(permuted);
+    };
+    auto keep = [](auto value) { return value; };
+    permute(label_begin_, keep);
+    permute(label_length_, keep);
+    permute(first_byte_, keep);
+    permute(key_id_, keep);
+    permute(first_child_, renumber);
+    permute(next_sibling_, renumber);
+  }
+
+  size_t GetKeyCount() const { return key_count_; }
+  size_t GetNodeCount() const { return label_begin_.size(); }
+
+  size_t GetMemoryUsage() const {
+    return keys_.capacity() + first_byte_.capacity() +
+           (label_begin_.capacity() + label_length_.capacity() +
+            first_child_.capacity() + next_sibling_.capacity() +
+            key_id_.capacity()) *
+               sizeof(uint32_t);
+  }
+
+ private:
+  std::string keys_;
+  std::vector<uint32_t> label_begin_;
+  std::vector<uint32_t> label_length_;
+  // keys_[label_begin_[v]], sibling scans do not touch keys_
+  std::vector<char> first_byte_;
+  std::vector<uint32_t> first_child_;
+  std::vector<uint32_t> next_sibling_;
+  std::vector<uint32_t> key_id_;
+  uint32_t key_count_ = 0;
+
+  uint32_t AddNode(uint32_t label_begin, uint32_t label_length) {
+    label_begin_.push_back(label_begin);
+    label_length_.push_back(label_length);
+    first_byte_.push_back(label_length > 0 ? keys_[label_begin] : '\0');
+    first_child_.push_back(kNone);
+    next_sibling_.push_back(kNone);
+    key_id_.push_back(kNone);
+    return label_begin_.size() - 1;
+  }
+
+  std::string_view GetLabel(uint32_t node) const {
+    return std::string_view(keys_).substr(label_begin_[node],
+                                          label_length_[node]);
+  }
+
+  static size_t GetCommonPrefix(std::string_view lhs, std::string_view rhs) {
+    size_t length = 0;
+    while (length < lhs.size() && length < rhs.size() &&
+           lhs[length] == rhs[length]) {
+      ++length;
+    }
+    return length;
+  }
+
+  // first child whose label starts with a byte >= character, previous is
+  // the sibling before it or kNone
+  uint32_t FindChild(uint32_t node, char character, uint32_t& previous) const {
+    uint8_t byte = character;
+    uint32_t child = first_child_[node];
+    previous = kNone;
+    while (child != kNone &&
+           static_cast<uint8_t>(first_byte_[child]) < byte) {
+      previous = child;
+      child = next_sibling_[child];
+    }
+    return child;
+  }
+
+  void LinkChild(uint32_t node, uint32_t previous, uint32_t child) {
+    uint32_t& slot =
+        (previous == kNone) ? first_child_[node] : next_sibling_[previous];
+    next_sibling_[child] = slot;
+    slot = child;
+  }
+
+  // end of a string in the trie: inside the edge into node, with below
+  // label characters left under it; node is kNone if the string leaves the
+  // trie
+  struct Locus {
+    uint32_t node;
+    size_t below;
+  };
+
+  Locus Descend(std::string_view str) const {
+    uint32_t node = kRoot;
+    size_t pos = 0;
+    while (pos < str.size()) {
+      uint32_t previous = kNone;
+      uint32_t child = FindChild(node, str[pos], previous);
+      if (child == kNone || first_byte_[child] != str[pos]) {
+        return {kNone, 0};
+      }
+      std::string_view label = GetLabel(child);
+      size_t common = GetCommonPrefix(label, str.substr(pos));
+      if (common < label.size()) {
+        return (pos + common == str.size())
+                   ? Locus{child, label.size() - common}
+                   : Locus{kNone, 0};
+      }
+      node = child;
+      pos += common;
+    }
+    return {node, 0};
+  }
+};
+
+// one node per character, as AhoKorasikTrie in K.cpp builds before
+// BuildAutomaton; the baseline of Benchmark
+class CharacterTrie {
+ public:
+  static const size_t kAlphabetSize = 26;
+  static const char kFirstChar = 'a';
+  static constexpr uint32_t kRoot = 0;
+  static constexpr uint32_t kNone = UINT32_MAX;
+
+  CharacterTrie() { AddNode(); }
+
+  void AddString(const std::string& str) {
+    uint32_t current = kRoot;
+    for (char character : str) {
+      size_t index = character - kFirstChar;
+      if (go_[current][index] == kNone) {
+        uint32_t node = AddNode();
+        go_[current][index] = node;
+      }
+      current = go_[current][index];
+    }
+    is_terminal_[current] = true;
+  }
+
+  bool Find(const std::string& str) const {
+    uint32_t current = kRoot;
+    for (char character : str) {
+      current = go_[current][character - kFirstChar];
+      if (current == kNone) {
+        return false;
+      }
+    }
+    return is_terminal_[current];
+  }
+
+  size_t GetMemoryUsage() const {
+    return go_.capacity() * sizeof(go_[0]) + is_terminal_.capacity() / 8;
+  }
+
+ private:
+  std::vector<std::array<uint32_t, kAlphabetSize>> go_;
+  std::vector<bool> is_terminal_;
+
+  uint32_t AddNode() {
+    go_.emplace_back();
+    go_.back().fill(kNone);
+    is_terminal_.push_back(false);
+    return go_.size() - 1;
+  }
+};
+
+// keys share one of a few long prefixes, like URLs or file paths; prints
+// bytes per key and ns per Find for both tries, the character trie is built
+// from RadixTrie::ForEachKey
+void Benchmark(size_t key_count, size_t prefix_count, size_t prefix_length,
+               size_t suffix_length) {
+  std::mt19937 generator(42);
+  auto random_string = [&](size_t size) {
+    std::string str(size, 'a');
+    for (char& character : str) {
+      character = 'a' + generator() % 26;
+    }
+    return str;
+  };
+
+  std::vector<std::string> prefixes(prefix_count);
+  for (auto& prefix : prefixes) {
+    prefix = random_string(prefix_length);
+  }
+  std::vector<std::string> keys(key_count);
+  for (auto& key : keys) {
+    key = prefixes[generator() % prefix_count] + random_string(suffix_length);
+  }
+
+  RadixTrie radix_trie;
+  for (const auto& key : keys) {
+    radix_trie.Insert(key);
+  }
+  radix_trie.RenumberInBFSOrder();
+  CharacterTrie character_trie;
+  radix_trie.ForEachKey([&](const std::string& key, uint32_t) {
+    character_trie.AddString(key);
+  });
+
+  std::shuffle(keys.begin(), keys.end(), generator);
+  size_t found = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (const auto& key : keys) {
+    found += radix_trie.Find(key).has_value() ? 1 : 0;
+  }
+  auto middle = std::chrono::steady_clock::now();
+  for (const auto& key : keys) {
+    found += character_trie.Find(key) ? 1 : 0;
+  }
+  auto end = std::chrono::steady_clock::now();
+
+  std::chrono::duration<double, std::nano> radix_time = middle - start;
+  std::chrono::duration<double, std::nano> character_time = end - middle;
+  std::cout << "radix:     "
+            << static_cast<double>(radix_trie.GetMemoryUsage()) / key_count
+            << " bytes/key, " << radix_time.count() / key_count
+            << " ns/find\n";
+  std::cout << "character: "
+            << static_cast<double>(character_trie.GetMemoryUsage()) / key_count
+            << " bytes/key, " << character_time.count() / key_count
+            << " ns/find\n";
+  std::cout << found << " found\n";
+}
+
+// input: n keys, then q queries; for every query prints whether it is a
+// key, the longest key that is its prefix (-1 if none) and the number of
+// keys starting with it
+int main() {
+  std::ios::sync_with_stdio(false);
+  std::cin.tie(nullptr);
+
+  size_t n = 0;
+  std::cin >> n;
+  RadixTrie trie;
+  for (size_t i = 0; i < n; ++i) {
+    std::string key;
+    std::cin >> key;
+    trie.Insert(key);
+  }
+  trie.RenumberInBFSOrder();
+
+  size_t q = 0;
+  std::cin >> q;
+  for (size_t i = 0; i < q; ++i) {
+    std::string query;
+    std::cin >> query;
+
+    auto longest = trie.FindLongestPrefix(query);
+    size_t with_prefix = 0;
+    trie.ForEachKeyWithPrefix(query,
+                              [&](const std::string&, uint32_t) { ++with_prefix; });
+
+    std::cout << (trie.Find(query).has_value() ? 1 : 0) << ' '
+              << (longest.has_value() ? static_cast<int64_t>(*longest) : -1)
+              << ' ' << with_prefix << '\n';
+  }
+
+  // Benchmark(1'000'000, 1'000, 40, 12);
+
+  return 0;
+}
@@ -0,0 +1,273 @@
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+// suffix automaton of the whole text; prefix_states[r] is the state of the
+// prefix of length r, lengths of state v are (length[link[v]], length[v]]
+class SuffixAutomaton {
+ public:
+  static const size_t kAlphabetSize = 26;
+  static const char kFirstChar = 'a';
+
+  explicit SuffixAutomaton(const std::string& text) {
+    length_.reserve(2 * text.size() + 1);
+    link_.reserve(2 * text.size() + 1);
+    next_.reserve(2 * text.size() + 1);
+    AddState(0, -1);
+    prefix_states_.push_back(0);
+
+    for (char character : text) {
+      AddCharacter(character - kFirstChar);
+      prefix_states_.push_back(last_);
+    }
+  }
+
+  const std::vector<int>& GetLengths() const { return length_; }
+  const std::vector<int>& GetLinks() const { return link_; }
+  const std::vector<int>& GetPrefixStates() const { return prefix_states_; }
+
+ private:
+  std::vector<int> length_;
+  std::vector<int> link_;
+  std::vector<std::array<int, kAlphabetSize>> next_;
+  std::vector<int> prefix_states_;
+  int last_ = 0;
+
+  int AddState(int length, int link) {
+    length_.push_back(length);
+    link_.push_back(link);
+    next_.emplace_back();
+    next_.back().fill(-1);
+    return length_.size() - 1;
+  }
+
+  void AddCharacter(size_t index) {
+    int current = AddState(length_[last_] + 1, 0);
+    int i = last_;
+
+    while (i != -1 && next_[i][index] == -1) {
+      next_[i][index] = current;
+      i = link_[i];
+    }
+
+    if (i != -1) {
+      int j = next_[i][index];
+      if (length_[i] + 1 == length_[j]) {
+        link_[current] = j;
+      } else {
+        int clone = AddState(length_[i] + 1, link_[j]);
+        next_[clone] = next_[j];
+        while (i != -1 && next_[i][index] == j) {
+          next_[i][index] = clone;
+          i = link_[i];
+        }
+        link_[j] = link_[current] = clone;
+      }
+    }
+
+    last_ = current;
+  }
+};
+
+// link-cut tree over a fixed rooted forest; every preferred path stores one
+// value, Access assigns a value to a root path and reports the replaced
+// pieces
+class LinkCutTree {
+ public:
+  explicit LinkCutTree(const std::vector<int>& parent)
+      : parent_(parent),
+        child_(parent.size(), {-1, -1}),
+        value_(parent.size(), 0),
+        tag_(parent.size(), 0) {}
+
+  // pieces are (deepest node, old value), from v up to the root
+  void Access(int v, int value, std::vector<std::pair<int, int>>& pieces) {
+    pieces.clear();
+    int last = -1;
+    for (int u = v; u != -1; u = parent_[u]) {
+      Splay(u);
+      pieces.emplace_back(u, value_[u]);
+      child_[u][1] = last;
+      last = u;
+    }
+    Splay(v);
+    Assign(v, value);
+  }
+
+ private:
+  std::vector<int> parent_;
+  std::vector<std::array<int, 2>> child_;
+  std::vector<int> value_;
+  std::vector<int> tag_;
+  std::vector<int> stack_;
+
+  bool IsSplayRoot(int x) const {
+    int p = parent_[x];
+    return p == -1 || (child_[p][0] != x && child_[p][1] != x);
+  }
+
+  void Assign(int x, int value) {
+    if (x != -1) {
+      value_[x] = value;
+      tag_[x] = value;
+    }
+  }
+
+  void Push(int x) {
+    if (tag_[x] != 0) {
+      Assign(child_[x][0], tag_[x]);
+      Assign(child_[x][1], tag_[x]);
+      tag_[x] = 0;
+    }
+  }
+
+  void Rotate(int x) {
+    int p = parent_[x];
+    int g = parent_[p];
+    int dir = (child_[p][1] == x) ? 1 : 0;
+    if (!IsSplayRoot(p)) {
+      child_[g][child_[g][1] == p ? 1 : 0] = x;
+    }
+    parent_[x] = g;
+    child_[p][dir] = child_[x][dir ^ 1];
+    if (child_[p][dir] != -1) {
+      parent_[child_[p][dir]] = p;
+    }
+    child_[x][dir ^ 1] = p;
+    parent_[p] = x;
+  }
+
+  void Splay(int x) {
+    stack_.clear();
+    for (int y = x;; y = parent_[y]) {
+      stack_.push_back(y);
+      if (IsSplayRoot(y)) {
+        break;
+      }
+    }
+    for (auto it = stack_.rbegin(); it != stack_.rend(); ++it) {
+      Push(*it);
+    }
+
+    while (!IsSplayRoot(x)) {
+      int p = parent_[x];
+      if (!IsSplayRoot(p)) {
+        int g = parent_[p];
+        bool zig_zig = (child_[g][0] == p) == (child_[p][0] == x);
+        Rotate(zig_zig ? p : x);
+      }
+      Rotate(x);
+    }
+  }
+};
+
+// range add, range sum over [1, n]
+class FenwickTree {
+ public:
+  explicit FenwickTree(int n) : linear_(n + 2, 0), constant_(n + 2, 0) {}
+
+  void RangeAdd(int l, int r, int64_t delta) {
+    Add(l, delta);
+    Add(r + 1, -delta);
+  }
+
+  int64_t RangeSum(int l, int r) const { return PrefixSum(r) - PrefixSum(l - 1); }
+
+ private:
+  std::vector<int64_t> linear_;
+  std::vector<int64_t> constant_;
+
+  void Add(int position, int64_t delta) {
+    int64_t shift = delta * (position - 1);
+    for (int i = position; i < static_cast<int>(linear_.size()); i += i & -i) {
+      linear_[i] += delta;
+      constant_[i] += shift;
+    }
+  }
+
+  int64_t PrefixSum(int position) const {
+    int64_t linear = 0;
+    int64_t constant = 0;
+    for (int i = position; i > 0; i -= i & -i) {
+      linear += linear_[i];
+      constant += constant_[i];
+    }
+    return linear * position - constant;
+  }
+};
+
+struct Query {
+  int left;
+  int right;
+  size_t index;
+};
+
+// sweep r: every distinct substring of text[1..r] is counted once, at the
+// start of its last occurrence; accessing the prefix state r in the suffix
+// link tree moves every suffix of text[1..r] to end r, and each replaced
+// piece with old end x shifts its starts x - hi + 1 .. x - lo; the answer
+// for [l, r] is the count over starts >= l, O((n + q) log^2 n) in total
+std::vector<int64_t> CountDistinctSubstrings(const std::string& text,
+                                             std::vector<Query> queries) {
+  int n = text.size();
+  SuffixAutomaton automaton(text);
+  const auto& length = automaton.GetLengths();
+  const auto& prefix_states = automaton.GetPrefixStates();
+
+  LinkCutTree tree(automaton.GetLinks());
+  FenwickTree starts(n);
+  std::vector<std::pair<int, int>> pieces;
+
+  std::sort(queries.begin(), queries.end(),
+            [](const Query& lhs, const Query& rhs) { return lhs.right < rhs.right; });
+  std::vector<int64_t> result(queries.size(), 0);
+  size_t next_query = 0;
+
+  for (int r = 1; r <= n; ++r) {
+    int state = prefix_states[r];
+    tree.Access(state, r, pieces);
+
+    for (size_t k = 0; k < pieces.size(); ++k) {
+      auto [node, end] = pieces[k];
+      int high = length[node];
+      int low = (k + 1 < pieces.size()) ? length[pieces[k + 1].first] : 0;
+      if (end != 0 && low < high) {
+        starts.RangeAdd(end - high + 1, end - low, -1);
+      }
+    }
+    starts.RangeAdd(r - length[state] + 1, r, 1);
+
+    for (; next_query < queries.size() && queries[next_query].right == r;
+         ++next_query) {
+      result[queries[next_query].index] =
+          starts.RangeSum(queries[next_query].left, r);
+    }
+  }
+
+  return result;
+}
+
+int main() {
+  std::ios::sync_with_stdio(false);
+  std::cin.tie(nullptr);
+
+  std::string text;
+  size_t q = 0;
+  std::cin >> text >> q;
+
+  std::vector<Query> queries(q);
+  for (size_t i = 0; i < q; ++i) {
+    std::cin >> queries[i].left >> queries[i].right;
+    queries[i].index = i;
+  }
+
+  for (int64_t count : CountDistinctSubstrings(text, std::move(queries))) {
+    std::cout << count << '\n';
+  }
+
+  return 0;
+}
@@ -0,0 +1,184 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// polynomial hash modulo 2^61 - 1 with a random base, LCE by binary search
+class SubstringHasher {
+ public:
+  explicit SubstringHasher(const std::string& str)
+      : hash_(str.size() + 1, 0), power_(str.size() + 1, 1) {
+    uint64_t base =
+        kMinBase + std::chrono::steady_clock::now().time_since_epoch().count() %
+                       (kMod - 2 * kMinBase);
+    for (size_t i = 0; i < str.size(); ++i) {
+      hash_[i + 1] = Add(Multiply(hash_[i], base), static_cast<uint8_t>(str[i]));
+      power_[i + 1] = Multiply(power_[i], base);
+    }
+  }
+
+  // hash of str[l..r)
+  uint64_t GetHash(size_t l, size_t r) const {
+    return Add(hash_[r], kMod - Multiply(hash_[l], power_[r - l]));
+  }
+
+  // longest common prefix of str[i..] and str[j..]
+  size_t GetCommonPrefix(size_t i, size_t j) const {
+    size_t low = 0;
+    size_t high = hash_.size() - 1 - std::max(i, j);
+    while (low < high) {
+      size_t middle = (low + high + 1) / 2;
+      if (GetHash(i, i + middle) == GetHash(j, j + middle)) {
+        low = middle;
+      } else {
+        high = middle - 1;
+      }
+    }
+    return low;
+  }
+
+  // longest common suffix of str[..i) and str[..j)
+  size_t GetCommonSuffix(size_t i, size_t j) const {
+    size_t low = 0;
+    size_t high = std::min(i, j);
+    while (low < high) {
+      size_t middle = (low + high + 1) / 2;
+      if (GetHash(i - middle, i) == GetHash(j - middle, j)) {
+        low = middle;
+      } else {
+        high = middle - 1;
+      }
+    }
+    return low;
+  }
+
+ private:
+  static const uint64_t kMod = (1ULL << 61) - 1;
+  static const uint64_t kMinBase = 1 << 8;
+
+  std::vector<uint64_t> hash_;
+  std::vector<uint64_t> power_;
+
+  static uint64_t Add(uint64_t lhs, uint64_t rhs) {
+    uint64_t sum = lhs + rhs;
+    return sum >= kMod ? sum - kMod : sum;
+  }
+
+  static uint64_t Multiply(uint64_t lhs, uint64_t rhs) {
+    unsigned __int128 product = static_cast<unsigned __int128>(lhs) * rhs;
+    uint64_t result = (static_cast<uint64_t>(product) & kMod) +
+                      static_cast<uint64_t>(product >> 61);
+    return result >= kMod ? result - kMod : result;
+  }
+};
+
+// maximal repetition str[begin..end) with the smallest period, end - begin
+// is at least 2 * period
+struct Run {
+  int64_t begin;
+  int64_t end;
+  int64_t period;
+
+  bool operator<(const Run& other) const {
+    return begin != other.begin ? begin < other.begin
+           : end != other.end   ? end < other.end
+                                : period < other.period;
+  }
+  bool operator==(const Run& other) const {
+    return begin == other.begin && end == other.end && period == other.period;
+  }
+};
+
+// lyndon[i] - length of the longest Lyndon word starting at i, i.e. the
+// distance to the next smaller suffix; inverted flips the letter order
+std::vector<int64_t> GetLyndonArray(const std::string& str,
+                                    const SubstringHasher& hasher,
+                                    bool inverted) {
+  int64_t n = str.size();
+  auto is_less = [&](int64_t i, int64_t j) {
+    int64_t common = hasher.GetCommonPrefix(i, j);
+    if (j + common == n) {
+      return false;
+    }
+    if (i + common == n) {
+      return true;
+    }
+    return (static_cast<uint8_t>(str[i + common]) <
+            static_cast<uint8_t>(str[j + common])) != inverted;
+  };
+
+  std::vector<int64_t> lyndon(n);
+  std::vector<int64_t> stack;
+  for (int64_t i = n - 1; i >= 0; --i) {
+    while (!stack.empty() && is_less(i, stack.back())) {
+      stack.pop_back();
+    }
+    lyndon[i] = (stack.empty() ? n : stack.back()) - i;
+    stack.push_back(i);
+  }
+  return lyndon;
+}
+
+// runs theorem: every run has a Lyndon root that is the longest Lyndon word
+// at its start for one of the two letter orders, so extending each longest
+// Lyndon word by LCE both ways finds all runs; O(n log n) time from the
+// hashed LCE, O(n) memory
+std::vector<Run> GetRuns(const std::string& str) {
+  int64_t n = str.size();
+  SubstringHasher hasher(str);
+  std::vector<Run> runs;
+
+  for (bool inverted : {false, true}) {
+    std::vector<int64_t> lyndon = GetLyndonArray(str, hasher, inverted);
+    for (int64_t i = 0; i < n; ++i) {
+      int64_t period = lyndon[i];
+      if (i + period >= n) {
+        continue;
+      }
+      int64_t end = i + period + hasher.GetCommonPrefix(i, i + period);
+      int64_t begin = i - hasher.GetCommonSuffix(i, i + period);
+      if (end - begin >= 2 * period) {
+        runs.push_back({begin, end, period});
+      }
+    }
+  }
+
+  std::sort(runs.begin(), runs.end());
+  runs.erase(std::unique(runs.begin(), runs.end()), runs.end());
+  return runs;
+}
+
+// occurrences of u^exponent for any u, every one lies in exactly one run,
+// the one whose period is the primitive root of u
+int64_t CountPowerOccurrences(const std::vector<Run>& runs, int64_t exponent) {
+  int64_t result = 0;
+  for (const Run& run : runs) {
+    int64_t length = run.end - run.begin;
+    for (int64_t root = run.period; exponent * root <= length;
+         root += run.period) {
+      result += length - exponent * root + 1;
+    }
+  }
+  return result;
+}
+
+int main() {
+  std::ios::sync_with_stdio(false);
+  std::cin.tie(nullptr);
+
+  std::string str;
+  std::cin >> str;
+
+  std::vector<Run> runs = GetRuns(str);
+
+  std::cout << runs.size() << '\n';
+  for (const Run& run : runs) {
+    std::cout << run.begin + 1 << ' ' << run.end << ' ' << run.period << '\n';
+  }
+  std::cout << CountPowerOccurrences(runs, 2) << ' '
+            << CountPowerOccurrences(runs, 3) << '\n';
+
+  return 0;
+}
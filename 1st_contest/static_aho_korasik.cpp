@@ -0,0 +1,229 @@
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+// string literal usable as a template argument
+template <size_t N>
+struct FixedString {
+  char data[N] = {};
+
+  constexpr FixedString(const char (&str)[N]) {
+    for (size_t i = 0; i < N; ++i) {
+      data[i] = str[i];
+    }
+  }
+
+  constexpr size_t Size() const { return N - 1; }
+  constexpr char operator[](size_t i) const { return data[i]; }
+};
+
+// Aho-Korasik over a pattern set fixed at compile time: the trie, the links
+// and the complete goto table are computed by the compiler and live in
+// .rodata, nothing is built at startup; states use the narrowest type that
+// fits the node count, so small sets get a byte-sized table
+template <FixedString... kPatterns>
+class StaticAhoKorasik {
+ public:
+  static constexpr size_t kAlphabetSize = 26;
+  static constexpr char kFirstChar = 'a';
+  static constexpr size_t kPatternCount = sizeof...(kPatterns);
+
+  static_assert(kPatternCount > 0 && ((kPatterns.Size() > 0) && ...),
+                "patterns must be non-empty");
+
+ private:
+  static constexpr uint32_t kNone = UINT32_MAX;
+  // one node per pattern character at most, plus the root
+  static constexpr size_t kMaxNodes = (size_t{1} + ... + kPatterns.Size());
+
+  struct Trie {
+    std::array<std::array<uint32_t, kAlphabetSize>, kMaxNodes> next{};
+    std::array<uint32_t, kPatternCount> pattern_nodes{};
+    size_t node_count = 1;
+  };
+
+  static constexpr Trie BuildTrie() {
+    Trie trie;
+    for (auto& row : trie.next) {
+      row.fill(kNone);
+    }
+
+    size_t id = 0;
+    auto add_string = [&](const auto& pattern) {
+      uint32_t current = 0;
+      for (size_t i = 0; i < pattern.Size(); ++i) {
+        size_t index = pattern[i] - kFirstChar;
+        if (trie.next[current][index] == kNone) {
+          trie.next[current][index] = trie.node_count++;
+        }
+        current = trie.next[current][index];
+      }
+      trie.pattern_nodes[id++] = current;
+    };
+    (add_string(kPatterns), ...);
+
+    return trie;
+  }
+
+  static constexpr Trie kTrie = BuildTrie();
+
+ public:
+  static constexpr size_t kNodeCount = kTrie.node_count;
+
+  using State = std::conditional_t<
+      kNodeCount <= UINT8_MAX + 1, uint8_t,
+      std::conditional_t<kNodeCount <= UINT16_MAX + 1, uint16_t, uint32_t>>;
+
+ private:
+  // the root is never terminal, so 0 doubles as "no dictionary link"
+  struct Automaton {
+    std::array<std::array<State, kAlphabetSize>, kNodeCount> go{};
+    std::array<State, kNodeCount> dictionary_link{};
+    // node itself if terminal, its dictionary link otherwise
+    std::array<State, kNodeCount> first_output{};
+    std::array<uint32_t, kNodeCount> depth{};
+    // patterns ending at a node, itself or through links
+    std::array<uint32_t, kNodeCount> match_count{};
+    // ids of the patterns ending at v: ids[ids_begin[v]..ids_begin[v + 1])
+    std::array<uint32_t, kNodeCount + 1> ids_begin{};
+    std::array<uint32_t, kPatternCount> ids{};
+  };
+
+  static constexpr Automaton BuildAutomaton() {
+    Automaton automaton;
+
+    for (uint32_t node : kTrie.pattern_nodes) {
+      ++automaton.ids_begin[node + 1];
+    }
+    for (size_t node = 0; node < kNodeCount; ++node) {
+      automaton.ids_begin[node + 1] += automaton.ids_begin[node];
+    }
+    std::array<uint32_t, kNodeCount> fill{};
+    for (uint32_t id = 0; id < kPatternCount; ++id) {
+      uint32_t node = kTrie.pattern_nodes[id];
+      automaton.ids[automaton.ids_begin[node] + fill[node]++] = id;
+    }
+
+    // BFS, a link always points to a node popped earlier
+    std::array<uint32_t, kNodeCount> link{};
+    std::array<uint32_t, kNodeCount> queue{};
+    size_t queue_size = 1;
+    for (size_t head = 0; head < queue_size; ++head) {
+      uint32_t node = queue[head];
+      uint32_t own_count =
+          automaton.ids_begin[node + 1] - automaton.ids_begin[node];
+      if (node != 0) {
+        uint32_t suffix = link[node];
+        bool is_terminal =
+            automaton.ids_begin[suffix + 1] != automaton.ids_begin[suffix];
+        automaton.dictionary_link[node] =
+            is_terminal ? suffix : automaton.dictionary_link[suffix];
+        automaton.match_count[node] = own_count + automaton.match_count[suffix];
+        automaton.first_output[node] =
+            (own_count > 0) ? node : automaton.dictionary_link[node];
+      }
+
+      for (size_t i = 0; i < kAlphabetSize; ++i) {
+        uint32_t fallback = (node == 0) ? 0 : automaton.go[link[node]][i];
+        uint32_t child = kTrie.next[node][i];
+        if (child != kNone) {
+          link[child] = fallback;
+          automaton.depth[child] = automaton.depth[node] + 1;
+          automaton.go[node][i] = child;
+          queue[queue_size++] = child;
+        } else {
+          automaton.go[node][i] = fallback;
+        }
+      }
+    }
+
+    return automaton;
+  }
+
+  static constexpr Automaton kAutomaton = BuildAutomaton();
+
+  static constexpr State Advance(State node, char character) {
+    size_t index = character - kFirstChar;
+    return (index < kAlphabetSize) ? kAutomaton.go[node][index] : 0;
+  }
+
+ public:
+  // total number of occurrences of all patterns
+  static constexpr size_t CountMatches(std::string_view text) {
+    size_t result = 0;
+    State node = 0;
+    for (char character : text) {
+      node = Advance(node, character);
+      result += kAutomaton.match_count[node];
+    }
+    return result;
+  }
+
+  // on_match(position, id) for every occurrence, by end position
+  template <typename OnMatch>
+  static constexpr void Scan(std::string_view text, OnMatch&& on_match) {
+    State node = 0;
+    for (size_t i = 0; i < text.size(); ++i) {
+      node = Advance(node, text[i]);
+      for (State temp = kAutomaton.first_output[node]; temp != 0;
+           temp = kAutomaton.dictionary_link[temp]) {
+        for (uint32_t it = kAutomaton.ids_begin[temp];
+             it < kAutomaton.ids_begin[temp + 1]; ++it) {
+          on_match(i + 1 - kAutomaton.depth[temp], kAutomaton.ids[it]);
+        }
+      }
+    }
+  }
+};
+
+using Signatures = StaticAhoKorasik<"he", "she", "his", "hers">;
+
+// the whole automaton is usable in constant expressions
+static_assert(Signatures::CountMatches("ushers") == 3);
+static_assert(Signatures::kNodeCount == 10);
+static_assert(std::is_same_v<Signatures::State, uint8_t>);
+
+// CountMatches throughput in GB/s over random text
+void BenchmarkScan(size_t text_size) {
+  std::mt19937 generator(42);
+  std::string text(text_size, 'a');
+  for (char& character : text) {
+    character = 'a' + generator() % 26;
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  size_t matches = Signatures::CountMatches(text);
+  std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+
+  std::cout << text_size / elapsed.count() / 1e9 << " GB/s, " << matches
+            << " matches\n";
+}
+
+// prints the number of occurrences of the built-in signatures, then every
+// occurrence as "position id"
+int main() {
+  std::ios::sync_with_stdio(false);
+  std::cin.tie(nullptr);
+
+  std::string text;
+  std::cin >> text;
+
+  std::string output;
+  Signatures::Scan(text, [&](size_t position, uint32_t id) {
+    output += std::to_string(position);
+    output += ' ';
+    output += std::to_string(id);
+    output += '\n';
+  });
+  std::cout << Signatures::CountMatches(text) << '\n' << output;
+
+  // BenchmarkScan(1'000'000'000);
+
+  return 0;
+}
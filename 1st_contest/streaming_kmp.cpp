@@ -0,0 +1,137 @@
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+std::vector<size_t> GetPrefixFunction(const std::string& str) {
+  std::vector<size_t> prefix(str.size(), 0);
+  for (size_t i = 1; i < str.size(); ++i) {
+    size_t j = prefix[i - 1];
+    while (j > 0 && str[i] != str[j]) {
+      j = prefix[j - 1];
+    }
+    if (str[i] == str[j]) {
+      ++j;
+    }
+    prefix[i] = j;
+  }
+  return prefix;
+}
+
+// KMP compiled into a DFA over the pattern's own alphabet: bytes absent from
+// the pattern share class 0, so the table is (|pattern| + 1) x (classes)
+class KmpAutomaton {
+ public:
+  explicit KmpAutomaton(const std::string& pattern)
+      : pattern_size_(pattern.size()) {
+    char_class_.fill(0);
+    for (char character : pattern) {
+      uint8_t byte = character;
+      if (char_class_[byte] == 0) {
+        char_class_[byte] = class_count_++;
+      }
+    }
+
+    auto prefix = GetPrefixFunction(pattern);
+    transitions_.assign((pattern_size_ + 1) * class_count_, 0);
+    for (size_t state = 0; state <= pattern_size_; ++state) {
+      for (size_t char_class = 0; char_class < class_count_; ++char_class) {
+        size_t next = 0;
+        if (state < pattern_size_ &&
+            char_class_[static_cast<uint8_t>(pattern[state])] == char_class) {
+          next = state + 1;
+        } else if (state > 0) {
+          next = transitions_[prefix[state - 1] * class_count_ + char_class];
+        }
+        transitions_[state * class_count_ + char_class] = next;
+      }
+    }
+  }
+
+  // on_match(offset) gets the absolute stream offset of every occurrence
+  template <typename OnMatch>
+  void Feed(const char* data, size_t size, OnMatch&& on_match) {
+    if (pattern_size_ == 0) {
+      return;
+    }
+
+    uint32_t state = state_;
+    for (size_t i = 0; i < size; ++i) {
+      state = transitions_[state * class_count_ +
+                           char_class_[static_cast<uint8_t>(data[i])]];
+      if (state == pattern_size_) {
+        on_match(offset_ + i + 1 - pattern_size_);
+      }
+    }
+    state_ = state;
+    offset_ += size;
+  }
+
+ private:
+  size_t pattern_size_;
+  size_t class_count_ = 1;
+  std::array<uint16_t, 256> char_class_;
+  std::vector<uint32_t> transitions_;
+
+  uint32_t state_ = 0;
+  uint64_t offset_ = 0;
+};
+
+// reads up to size bytes as soon as any are available, 0 at end of input
+size_t ReadAvailable(char* data, size_t size) {
+  while (true) {
+    ssize_t count = read(STDIN_FILENO, data, size);
+    if (count >= 0) {
+      return count;
+    }
+    if (errno != EINTR) {
+      return 0;
+    }
+  }
+}
+
+// first line is the pattern, the rest of the input is the stream; reads
+// return whatever the pipe holds, so matches in a tailed log are printed
+// as soon as their bytes arrive
+int main() {
+  static const size_t kBufferSize = 1 << 16;
+
+  std::vector<char> buffer(kBufferSize);
+  std::string pattern;
+  size_t begin = 0;
+  size_t size = 0;
+  while (true) {
+    size = ReadAvailable(buffer.data(), kBufferSize);
+    if (size == 0) {
+      break;
+    }
+    auto newline = std::find(buffer.data(), buffer.data() + size, '\n');
+    pattern.append(buffer.data(), newline);
+    if (newline != buffer.data() + size) {
+      begin = newline - buffer.data() + 1;
+      break;
+    }
+  }
+
+  KmpAutomaton automaton(pattern);
+  std::string output;
+
+  while (size > 0) {
+    automaton.Feed(buffer.data() + begin, size - begin, [&](uint64_t offset) {
+      output += std::to_string(offset);
+      output += '\n';
+    });
+    std::cout << output << std::flush;
+    output.clear();
+
+    begin = 0;
+    size = ReadAvailable(buffer.data(), kBufferSize);
+  }
+
+  return 0;
+}